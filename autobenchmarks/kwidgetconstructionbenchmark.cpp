@@ -0,0 +1,197 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "residentmemory.h"
+
+#include <KCharSelect>
+#include <KColorCombo>
+#include <KDatePicker>
+#include <KDateTimeEdit>
+#include <KFontChooser>
+#include <KMessageWidget>
+#include <KMultiTabBar>
+#include <KPageDialog>
+#include <KPasswordDialog>
+#include <KRatingWidget>
+#include <KTitleWidget>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QLabel>
+#include <QProcess>
+#include <QPushButton>
+#include <QTest>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+
+struct WidgetFactory {
+    const char *name;
+    std::function<QWidget *()> create;
+};
+
+static const QList<WidgetFactory> &widgetFactories()
+{
+    static const QList<WidgetFactory> factories = {
+        {"KCharSelect",
+         []() {
+             return new KCharSelect(nullptr, KCharSelect::AllGuiElements);
+         }},
+        {"KColorCombo",
+         []() {
+             return new KColorCombo;
+         }},
+        {"KDatePicker",
+         []() {
+             return new KDatePicker;
+         }},
+        {"KDateTimeEdit",
+         []() {
+             return new KDateTimeEdit;
+         }},
+        {"KFontChooser",
+         []() {
+             return new KFontChooser;
+         }},
+        {"KMessageWidget",
+         []() {
+             return new KMessageWidget(QStringLiteral("Message"));
+         }},
+        {"KMultiTabBar",
+         []() {
+             return new KMultiTabBar;
+         }},
+        {"KPageDialog",
+         []() {
+             return new KPageDialog;
+         }},
+        {"KPasswordDialog",
+         []() {
+             return new KPasswordDialog;
+         }},
+        {"KRatingWidget",
+         []() {
+             return new KRatingWidget;
+         }},
+        {"KTitleWidget",
+         []() {
+             return new KTitleWidget;
+         }},
+    };
+    return factories;
+}
+
+// Constructs and polishes a widget for the first time in the process, and prints
+// the time it took in nanoseconds and the growth of the resident memory in bytes
+static int constructWidget(const QByteArray &name)
+{
+    const QList<WidgetFactory> &factories = widgetFactories();
+    const auto it = std::find_if(factories.cbegin(), factories.cend(), [&name](const WidgetFactory &factory) {
+        return name == factory.name;
+    });
+    if (it == factories.cend()) {
+        return 1;
+    }
+
+    // Qt initializes styles and fonts on first use, which is not the cost of the widget
+    {
+        QLabel label(QStringLiteral("Warm up"));
+        QPushButton button(QStringLiteral("Warm up"));
+        label.ensurePolished();
+        button.ensurePolished();
+        label.sizeHint();
+        button.sizeHint();
+    }
+
+    const qint64 residentBefore = residentMemory();
+    QElapsedTimer timer;
+    timer.start();
+    std::unique_ptr<QWidget> widget(it->create());
+    widget->ensurePolished();
+    widget->sizeHint();
+    const qint64 nsecs = timer.nsecsElapsed();
+    const qint64 residentBytes = residentBefore >= 0 ? residentMemory() - residentBefore : -1;
+
+    printf("%lld %lld\n", nsecs, residentBytes);
+    return 0;
+}
+
+// Every widget is constructed in a new process, since only the first construction pays
+// for the lazily initialized data, resources and plugins of the library
+class KWidgetConstructionBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    static std::pair<qint64, qint64> measure(const char *name)
+    {
+        QProcess process;
+        process.start(QCoreApplication::applicationFilePath(), {QStringLiteral("--construct"), QString::fromLatin1(name)});
+        if (!process.waitForFinished() || process.exitCode() != 0) {
+            return {-1, -1};
+        }
+
+        const QList<QByteArray> results = process.readAllStandardOutput().trimmed().split(' ');
+        if (results.size() != 2) {
+            return {-1, -1};
+        }
+        return {results.at(0).toLongLong(), results.at(1).toLongLong()};
+    }
+
+    static void addRows()
+    {
+        QTest::addColumn<QByteArray>("widget");
+        for (const WidgetFactory &factory : widgetFactories()) {
+            QTest::newRow(factory.name) << QByteArray(factory.name);
+        }
+    }
+
+private Q_SLOTS:
+    void benchmarkFirstConstruction_data()
+    {
+        addRows();
+    }
+
+    void benchmarkFirstConstruction()
+    {
+        QFETCH(QByteArray, widget);
+        const qint64 nsecs = measure(widget.constData()).first;
+        QVERIFY(nsecs >= 0);
+        QTest::setBenchmarkResult(nsecs, QTest::WalltimeNanoseconds);
+    }
+
+    void benchmarkFirstConstructionResidentMemory_data()
+    {
+        addRows();
+    }
+
+    void benchmarkFirstConstructionResidentMemory()
+    {
+        QFETCH(QByteArray, widget);
+        const auto [nsecs, residentBytes] = measure(widget.constData());
+        QVERIFY(nsecs >= 0);
+        if (residentBytes < 0) {
+            QSKIP("The resident memory is not known on this platform");
+        }
+        QTest::setBenchmarkResult(residentBytes, QTest::BytesAllocated);
+    }
+};
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+    if (argc == 3 && qstrcmp(argv[1], "--construct") == 0) {
+        return constructWidget(argv[2]);
+    }
+
+    KWidgetConstructionBenchmark benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "kwidgetconstructionbenchmark.moc"
@@ -0,0 +1,173 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KCapacityBar>
+#include <KCharSelect>
+#include <KCollapsibleGroupBox>
+#include <KColorButton>
+#include <KDatePicker>
+#include <KGradientSelector>
+#include <KLed>
+#include <KMessageWidget>
+#include <KMultiTabBar>
+#include <KRatingWidget>
+#include <KRuler>
+#include <KSeparator>
+#include <KSqueezedTextLabel>
+#include <KTitleWidget>
+
+#include <QIcon>
+#include <QImage>
+#include <QLabel>
+#include <QTest>
+#include <QVBoxLayout>
+
+#include <functional>
+#include <memory>
+
+struct WidgetFactory {
+    const char *name;
+    std::function<QWidget *()> create;
+};
+
+// The widgets benchmarked, set up with typical contents
+static const QList<WidgetFactory> &widgetFactories()
+{
+    static const QList<WidgetFactory> factories = {
+        {"KCapacityBar",
+         []() {
+             auto bar = new KCapacityBar(KCapacityBar::DrawTextInline);
+             bar->setValue(60);
+             bar->setText(QStringLiteral("60 GiB of 100 GiB used"));
+             return bar;
+         }},
+        {"KCharSelect",
+         []() {
+             return new KCharSelect(nullptr, KCharSelect::AllGuiElements);
+         }},
+        {"KCollapsibleGroupBox",
+         []() {
+             auto groupBox = new KCollapsibleGroupBox;
+             groupBox->setTitle(QStringLiteral("Advanced"));
+             auto layout = new QVBoxLayout(groupBox);
+             layout->addWidget(new QLabel(QStringLiteral("Contents")));
+             groupBox->expand();
+             return groupBox;
+         }},
+        {"KColorButton",
+         []() {
+             return new KColorButton(Qt::darkCyan);
+         }},
+        {"KDatePicker",
+         []() {
+             return new KDatePicker(QDate(2026, 1, 15));
+         }},
+        {"KGradientSelector",
+         []() {
+             auto selector = new KGradientSelector(Qt::Horizontal);
+             selector->setColors(Qt::black, Qt::red);
+             selector->setValue(40);
+             return selector;
+         }},
+        {"KLed",
+         []() {
+             return new KLed(Qt::green);
+         }},
+        {"KMessageWidget",
+         []() {
+             auto widget = new KMessageWidget(QStringLiteral("The document was modified by another program."));
+             widget->setMessageType(KMessageWidget::Warning);
+             widget->setCloseButtonVisible(true);
+             return widget;
+         }},
+        {"KMultiTabBar",
+         []() {
+             auto tabBar = new KMultiTabBar(KMultiTabBar::Bottom);
+             tabBar->appendTab(QIcon::fromTheme(QStringLiteral("document-open")), 0, QStringLiteral("Files"));
+             tabBar->appendTab(QIcon::fromTheme(QStringLiteral("view-list-tree")), 1, QStringLiteral("Outline"));
+             tabBar->appendTab(QIcon::fromTheme(QStringLiteral("utilities-terminal")), 2, QStringLiteral("Terminal"));
+             tabBar->setTab(1, true);
+             return tabBar;
+         }},
+        {"KRatingWidget",
+         []() {
+             auto rating = new KRatingWidget;
+             rating->setRating(7);
+             return rating;
+         }},
+        {"KRuler",
+         []() {
+             return new KRuler(Qt::Horizontal);
+         }},
+        {"KSeparator",
+         []() {
+             return new KSeparator(Qt::Horizontal);
+         }},
+        {"KSqueezedTextLabel",
+         []() {
+             return new KSqueezedTextLabel(QStringLiteral("/home/user/Documents/Projects/a rather long path/to/some/file.txt"));
+         }},
+        {"KTitleWidget",
+         []() {
+             auto title = new KTitleWidget;
+             title->setText(QStringLiteral("Settings"));
+             title->setComment(QStringLiteral("Configure the application"));
+             title->setIcon(QIcon::fromTheme(QStringLiteral("configure")), KTitleWidget::ImageLeft);
+             return title;
+         }},
+    };
+    return factories;
+}
+
+class KWidgetPaintBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkRender_data()
+    {
+        QTest::addColumn<int>("widget");
+        QTest::addColumn<qreal>("scale");
+        QTest::addColumn<qreal>("dpr");
+
+        const QList<WidgetFactory> &factories = widgetFactories();
+        for (int widget = 0; widget < factories.size(); ++widget) {
+            for (qreal scale : {1.0, 2.0}) {
+                for (qreal dpr : {1.0, 1.5, 2.0}) {
+                    QTest::addRow("%s %gx @%g", factories.at(widget).name, scale, dpr) << widget << scale << dpr;
+                }
+            }
+        }
+    }
+
+    void benchmarkRender()
+    {
+        QFETCH(int, widget);
+        QFETCH(qreal, scale);
+        QFETCH(qreal, dpr);
+
+        std::unique_ptr<QWidget> w(widgetFactories().at(widget).create());
+        w->ensurePolished();
+        const QSize size = w->sizeHint().expandedTo(QSize(16, 16)) * scale;
+        w->resize(size);
+
+        QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+
+        // The first rendering lays the widget out and fills its caches, which is not what is measured
+        w->render(&image);
+
+        QBENCHMARK {
+            w->render(&image);
+        }
+    }
+};
+
+QTEST_MAIN(KWidgetPaintBenchmark)
+
+#include "kwidgetpaintbenchmark.moc"
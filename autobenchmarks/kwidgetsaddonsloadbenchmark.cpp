@@ -0,0 +1,56 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "residentmemory.h"
+
+#include <QElapsedTimer>
+#include <QLibrary>
+#include <QTest>
+
+// Not linked to KF6WidgetsAddons, loads it at runtime to measure what loading it costs.
+// A library is loaded once per process, so it is loaded once and both results are reported.
+class KWidgetsAddonsLoadBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QVERIFY2(!m_library.isLoaded(), "the library is already loaded");
+
+        const qint64 residentBefore = residentMemory();
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY2(m_library.load(), qPrintable(m_library.errorString()));
+        m_loadNsecs = timer.nsecsElapsed();
+        if (residentBefore >= 0) {
+            m_residentBytes = residentMemory() - residentBefore;
+        }
+    }
+
+    void benchmarkLoadTime()
+    {
+        QTest::setBenchmarkResult(m_loadNsecs, QTest::WalltimeNanoseconds);
+    }
+
+    void benchmarkLoadResidentMemory()
+    {
+        if (m_residentBytes < 0) {
+            QSKIP("The resident memory is not known on this platform");
+        }
+        QTest::setBenchmarkResult(m_residentBytes, QTest::BytesAllocated);
+    }
+
+private:
+    QLibrary m_library{QStringLiteral(KWIDGETSADDONS_LIBRARY)};
+    qint64 m_loadNsecs = 0;
+    qint64 m_residentBytes = -1;
+};
+
+QTEST_MAIN(KWidgetsAddonsLoadBenchmark)
+
+#include "kwidgetsaddonsloadbenchmark.moc"
@@ -0,0 +1,33 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef RESIDENTMEMORY_H
+#define RESIDENTMEMORY_H
+
+#include <QFile>
+#include <QList>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+// Returns the resident memory of the process in bytes, or -1 where it is not known
+inline qint64 residentMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+    return -1;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "fontcatalog_p.h"
+#include "fonthelpers_p.h"
+
+#include <QFontDatabase>
+#include <QListWidget>
+#include <QTest>
+#include <QTranslator>
+
+// Puts the font styles in brackets, as another language would change them
+class StyleTranslator : public QTranslator
+{
+public:
+    QString translate(const char *context, const char *sourceText, const char *disambiguation, int n) const override
+    {
+        Q_UNUSED(n)
+        if (qstrcmp(context, "KFontChooser") == 0 && qstrcmp(sourceText, "%1") == 0 && qstrcmp(disambiguation, "@item Font style") == 0) {
+            return QStringLiteral("[%1]");
+        }
+        return QString();
+    }
+
+    bool isEmpty() const override
+    {
+        return false;
+    }
+};
+
+static QStringList texts(const QListWidget &list)
+{
+    QStringList result;
+    for (int row = 0; row < list.count(); ++row) {
+        result.append(list.item(row)->text());
+    }
+    return result;
+}
+
+class FontCatalogTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testStylesFollowLanguage()
+    {
+        const QString family = QFontDatabase::systemFont(QFontDatabase::GeneralFont).family();
+        const QList<KFontCatalog::Style> styles = KFontCatalog::self()->styles(family);
+        if (styles.isEmpty()) {
+            QSKIP("The system font has no usable styles");
+        }
+        for (const KFontCatalog::Style &style : styles) {
+            QCOMPARE(style.text, style.name);
+        }
+
+        StyleTranslator translator;
+        QVERIFY(QCoreApplication::installTranslator(&translator));
+        const QList<KFontCatalog::Style> translated = KFontCatalog::self()->styles(family);
+        QCoreApplication::removeTranslator(&translator);
+
+        QCOMPARE(translated.size(), styles.size());
+        for (int i = 0; i < styles.size(); ++i) {
+            QCOMPARE(translated.at(i).text, QLatin1Char('[') + styles.at(i).name + QLatin1Char(']'));
+            QCOMPARE(translated.at(i).name, styles.at(i).name);
+            QCOMPARE(translated.at(i).identifier, styles.at(i).identifier);
+        }
+
+        QCOMPARE(KFontCatalog::self()->styles(family).constFirst().text, styles.constFirst().text);
+    }
+
+    void testSyncListItems()
+    {
+        QListWidget list;
+        syncListItems(&list, {QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")});
+        QCOMPARE(texts(list), (QStringList{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")}));
+
+        // The rows are kept, only their texts change
+        QListWidgetItem *first = list.item(0);
+        QListWidgetItem *second = list.item(1);
+        list.setCurrentRow(1);
+        syncListItems(&list, {QStringLiteral("a"), QStringLiteral("x")});
+        QCOMPARE(texts(list), (QStringList{QStringLiteral("a"), QStringLiteral("x")}));
+        QCOMPARE(list.item(0), first);
+        QCOMPARE(list.item(1), second);
+        QCOMPARE(list.currentRow(), 1);
+
+        syncListItems(&list, {QStringLiteral("a"), QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z")});
+        QCOMPARE(texts(list), (QStringList{QStringLiteral("a"), QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z")}));
+        QCOMPARE(list.item(0), first);
+
+        syncListItems(&list, {});
+        QCOMPARE(list.count(), 0);
+    }
+};
+
+QTEST_MAIN(FontCatalogTest)
+
+#include "fontcatalogtest.moc"
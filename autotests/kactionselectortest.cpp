@@ -0,0 +1,169 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KActionSelector>
+
+#include <QListWidget>
+#include <QTest>
+
+static QStringList texts(const QListWidget *listWidget)
+{
+    QStringList result;
+    for (int row = 0; row < listWidget->count(); ++row) {
+        result.append(listWidget->item(row)->text());
+    }
+    return result;
+}
+
+static QStringList texts(const QList<QListWidgetItem *> &items)
+{
+    QStringList result;
+    for (const QListWidgetItem *item : items) {
+        result.append(item->text());
+    }
+    return result;
+}
+
+static void select(QListWidget *listWidget, const QStringList &selected)
+{
+    listWidget->clearSelection();
+    for (int row = 0; row < listWidget->count(); ++row) {
+        listWidget->item(row)->setSelected(selected.contains(listWidget->item(row)->text()));
+    }
+}
+
+// Moves the selected items with the keyboard, like the buttons do
+static void addSelected(KActionSelector &selector)
+{
+    QTest::keyClick(selector.availableListWidget(), Qt::Key_Right, Qt::ControlModifier);
+}
+
+static void removeSelected(KActionSelector &selector)
+{
+    QTest::keyClick(selector.selectedListWidget(), Qt::Key_Left, Qt::ControlModifier);
+}
+
+class KActionSelectorTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSortedMerge()
+    {
+        KActionSelector selector;
+        QCOMPARE(selector.availableInsertionPolicy(), KActionSelector::Sorted);
+        selector.availableListWidget()->addItems({QStringLiteral("a"), QStringLiteral("c"), QStringLiteral("e")});
+        selector.selectedListWidget()->addItems({QStringLiteral("f"), QStringLiteral("b"), QStringLiteral("d"), QStringLiteral("g")});
+
+        select(selector.selectedListWidget(), {QStringLiteral("f"), QStringLiteral("b"), QStringLiteral("d")});
+        removeSelected(selector);
+        QCOMPARE(texts(selector.availableListWidget()),
+                 (QStringList{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d"), QStringLiteral("e"), QStringLiteral("f")}));
+        QCOMPARE(texts(selector.selectedListWidget()), QStringList{QStringLiteral("g")});
+        // The last moved item, in row order
+        QCOMPARE(selector.availableListWidget()->currentItem()->text(), QStringLiteral("d"));
+    }
+
+    void testSortedUnsortedList()
+    {
+        KActionSelector selector;
+        selector.availableListWidget()->addItems({QStringLiteral("c"), QStringLiteral("a")});
+        selector.selectedListWidget()->addItems({QStringLiteral("b"), QStringLiteral("d")});
+
+        // A list which is not sorted yet is sorted as a whole
+        select(selector.selectedListWidget(), {QStringLiteral("b"), QStringLiteral("d")});
+        removeSelected(selector);
+        QCOMPARE(texts(selector.availableListWidget()), (QStringList{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d")}));
+        QVERIFY(selector.selectedListWidget()->count() == 0);
+    }
+
+    void testInsertionPolicy_data()
+    {
+        QTest::addColumn<KActionSelector::InsertionPolicy>("policy");
+        QTest::addColumn<int>("currentRow");
+        QTest::addColumn<QStringList>("expected");
+
+        QTest::newRow("below current") << KActionSelector::BelowCurrent << 0
+                                       << QStringList{QStringLiteral("x"), QStringLiteral("a"), QStringLiteral("c"), QStringLiteral("y"), QStringLiteral("z")};
+        QTest::newRow("below last") << KActionSelector::BelowCurrent << 2
+                                    << QStringList{QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z"), QStringLiteral("a"), QStringLiteral("c")};
+        QTest::newRow("below no current") << KActionSelector::BelowCurrent << -1
+                                          << QStringList{QStringLiteral("a"), QStringLiteral("c"), QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z")};
+        // Each item goes to the top in turn, as when they were moved one by one
+        QTest::newRow("at top") << KActionSelector::AtTop << 1
+                                << QStringList{QStringLiteral("c"), QStringLiteral("a"), QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z")};
+        QTest::newRow("at bottom") << KActionSelector::AtBottom << 0
+                                   << QStringList{QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z"), QStringLiteral("a"), QStringLiteral("c")};
+        QTest::newRow("sorted") << KActionSelector::Sorted << 0
+                                << QStringList{QStringLiteral("a"), QStringLiteral("c"), QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z")};
+    }
+
+    void testInsertionPolicy()
+    {
+        QFETCH(KActionSelector::InsertionPolicy, policy);
+        QFETCH(int, currentRow);
+        QFETCH(QStringList, expected);
+
+        KActionSelector selector;
+        selector.setSelectedInsertionPolicy(policy);
+        selector.availableListWidget()->addItems({QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")});
+        selector.selectedListWidget()->addItems({QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("z")});
+        selector.selectedListWidget()->setCurrentRow(currentRow, QItemSelectionModel::NoUpdate);
+
+        select(selector.availableListWidget(), {QStringLiteral("c"), QStringLiteral("a")});
+        addSelected(selector);
+        QCOMPARE(texts(selector.selectedListWidget()), expected);
+        QCOMPARE(texts(selector.availableListWidget()), QStringList{QStringLiteral("b")});
+        QCOMPARE(selector.selectedListWidget()->currentItem()->text(), QStringLiteral("c"));
+    }
+
+    void testSignals()
+    {
+        KActionSelector selector;
+        selector.availableListWidget()->addItems({QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")});
+
+        QStringList emitted;
+        connect(&selector, &KActionSelector::added, this, [&emitted](QListWidgetItem *item) {
+            emitted.append(QStringLiteral("added ") + item->text());
+        });
+        connect(&selector, &KActionSelector::addedItems, this, [&emitted](const QList<QListWidgetItem *> &items) {
+            emitted.append(QStringLiteral("addedItems ") + texts(items).join(QLatin1Char(',')));
+        });
+        connect(&selector, &KActionSelector::removed, this, [&emitted](QListWidgetItem *item) {
+            emitted.append(QStringLiteral("removed ") + item->text());
+        });
+        connect(&selector, &KActionSelector::removedItems, this, [&emitted](const QList<QListWidgetItem *> &items) {
+            emitted.append(QStringLiteral("removedItems ") + texts(items).join(QLatin1Char(',')));
+        });
+
+        // The items are moved in row order, added() is emitted for each before addedItems()
+        select(selector.availableListWidget(), {QStringLiteral("c"), QStringLiteral("a")});
+        addSelected(selector);
+        QCOMPARE(emitted, (QStringList{QStringLiteral("added a"), QStringLiteral("added c"), QStringLiteral("addedItems a,c")}));
+
+        emitted.clear();
+        select(selector.selectedListWidget(), {QStringLiteral("a"), QStringLiteral("c")});
+        removeSelected(selector);
+        QCOMPARE(emitted, (QStringList{QStringLiteral("removed a"), QStringLiteral("removed c"), QStringLiteral("removedItems a,c")}));
+
+        // A single item, moved with the keyboard or a double click
+        emitted.clear();
+        selector.availableListWidget()->setCurrentRow(1);
+        QTest::keyClick(selector.availableListWidget(), Qt::Key_Return);
+        QCOMPARE(emitted, (QStringList{QStringLiteral("added b"), QStringLiteral("addedItems b")}));
+
+        // Nothing selected, nothing moved
+        emitted.clear();
+        selector.availableListWidget()->clearSelection();
+        addSelected(selector);
+        QVERIFY(emitted.isEmpty());
+    }
+};
+
+QTEST_MAIN(KActionSelectorTest)
+
+#include "kactionselectortest.moc"
@@ -144,4 +144,43 @@ void KCollapsibleGroupBoxTest::testNoAnimationWhenHidden()
     QCOMPARE(collapsible.height(), collapsible.sizeHint().height());
 }
 
+void KCollapsibleGroupBoxTest::testGroupExpanded()
+{
+    QWidget window;
+    QVBoxLayout windowLayout(&window);
+
+    QList<KCollapsibleGroupBox *> boxes;
+    for (int i = 0; i < 3; ++i) {
+        auto collapsible = new KCollapsibleGroupBox(&window);
+        auto layout = new QVBoxLayout(collapsible);
+        auto label = new QLabel(collapsible);
+        label->setMinimumSize(QSize(100, 100));
+        layout->addWidget(label);
+        windowLayout.addWidget(collapsible);
+        boxes.append(collapsible);
+    }
+    // The ChildAdded event is processed asynchronously.
+    qApp->processEvents();
+
+    window.show();
+    const int collapsedHeight = boxes.first()->height();
+
+    KCollapsibleGroupBox::setGroupExpanded(boxes, true);
+    for (KCollapsibleGroupBox *collapsible : std::as_const(boxes)) {
+        QVERIFY(collapsible->isExpanded());
+        QCOMPARE(collapsible->height(), collapsedHeight);
+    }
+
+    const int animationDuration = qMax(1, window.style()->styleHint(QStyle::SH_Widget_Animation_Duration));
+    for (KCollapsibleGroupBox *collapsible : std::as_const(boxes)) {
+        QTRY_COMPARE_WITH_TIMEOUT(collapsible->height(), collapsible->sizeHint().height(), animationDuration + 40 + 10);
+    }
+
+    KCollapsibleGroupBox::setGroupExpanded(boxes, false);
+    for (KCollapsibleGroupBox *collapsible : std::as_const(boxes)) {
+        QVERIFY(!collapsible->isExpanded());
+        QTRY_COMPARE_WITH_TIMEOUT(collapsible->height(), collapsedHeight, animationDuration + 40 + 10);
+    }
+}
+
 #include "moc_kcollapsiblegroupbox_test.cpp"
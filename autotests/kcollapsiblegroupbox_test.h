@@ -20,6 +20,7 @@ private Q_SLOTS:
     void childShouldGetFocus();
     void testExpandAnimation();
     void testNoAnimationWhenHidden();
+    void testGroupExpanded();
 };
 
 #endif /* KCOLLAPSIBLEGROUPBOXTEST_H */
@@ -0,0 +1,70 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <kcolorfield.h>
+
+#include <QRegularExpression>
+#include <QTest>
+
+class KColorFieldTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static bool fuzzyCompare(QRgb actual, const QColor &expected)
+    {
+        return qAbs(qRed(actual) - expected.red()) <= 1 //
+            && qAbs(qGreen(actual) - expected.green()) <= 1 //
+            && qAbs(qBlue(actual) - expected.blue()) <= 1;
+    }
+
+private Q_SLOTS:
+    void testHueSaturation()
+    {
+        // 360 columns, one per degree, and 256 rows, one per saturation
+        const QImage image = KColorField::render(QSize(360, 256), KColorField::Hue, KColorField::Saturation, QColor::fromHsv(0, 0, 200));
+        QCOMPARE(image.size(), QSize(360, 256));
+        QCOMPARE(image.format(), QImage::Format_RGB32);
+
+        for (int hue = 0; hue < 360; hue += 7) {
+            for (int row = 0; row < 256; row += 15) {
+                const QColor expected = QColor::fromHsvF(hue / 360.0f, (255 - row) / 255.0f, 200 / 255.0f);
+                const QRgb actual = image.pixel(hue, row);
+                QVERIFY2(fuzzyCompare(actual, expected),
+                         qPrintable(QStringLiteral("hue %1 row %2: %3 instead of %4").arg(hue).arg(row).arg(QColor(actual).name(), expected.name())));
+            }
+        }
+    }
+
+    void testRedBlue()
+    {
+        const QImage image = KColorField::render(QSize(256, 256), KColorField::Red, KColorField::Blue, QColor(10, 20, 30));
+        QCOMPARE(image.pixel(0, 255), qRgb(0, 20, 0));
+        QCOMPARE(image.pixel(255, 0), qRgb(255, 20, 255));
+        QCOMPARE(image.pixel(128, 127), qRgb(128, 20, 128));
+    }
+
+    void testInvalidChannels()
+    {
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("invalid channels")));
+        QVERIFY(KColorField::render(QSize(10, 10), KColorField::Hue, KColorField::Red, Qt::red).isNull());
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("invalid channels")));
+        QVERIFY(KColorField::render(QSize(10, 10), KColorField::Value, KColorField::Value, Qt::red).isNull());
+        QVERIFY(KColorField::render(QSize(0, 10), KColorField::Hue, KColorField::Value, Qt::red).isNull());
+    }
+
+    void testRenderAsync()
+    {
+        const QColor color(50, 100, 150);
+        QFuture<QImage> future = KColorField::renderAsync(QSize(64, 32), KColorField::Saturation, KColorField::Value, color);
+        QCOMPARE(future.result(), KColorField::render(QSize(64, 32), KColorField::Saturation, KColorField::Value, color));
+    }
+};
+
+QTEST_MAIN(KColorFieldTest)
+
+#include "kcolorfieldtest.moc"
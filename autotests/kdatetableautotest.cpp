@@ -0,0 +1,185 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kdatetable_p.h"
+
+#include <QImage>
+#include <QTest>
+
+// A month which is not the current one, and whose selected day (the first) is not checked
+static const QDate MONTH(2026, 3, 1);
+
+static QDate day(int day)
+{
+    return QDate(MONTH.year(), MONTH.month(), day);
+}
+
+class TestDateTable : public KDateTable
+{
+public:
+    using KDateTable::dateFromPos;
+
+    int paintCount = 0;
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        ++paintCount;
+        KDateTable::paintEvent(event);
+    }
+};
+
+class KDateTableAutoTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    // The custom background of the cell of date, or an invalid color if it has none or is not shown.
+    // How much of the cell the background covers depends on the style.
+    static QColor cellBackground(TestDateTable &table, const QDate &date)
+    {
+        static const QList<QColor> backgrounds = {Qt::red, Qt::green, Qt::blue, Qt::yellow};
+
+        const QImage image = table.grab().toImage();
+        // The cell showing the date, posFromDate() is one past it
+        int pos = 0;
+        while (table.dateFromPos(pos) != date) {
+            if (++pos == 6 * 7) {
+                return QColor();
+            }
+        }
+        // The first row holds the names of the days
+        const int row = pos / 7 + 1;
+        const int col = pos % 7;
+        const QRectF cell(col * table.width() / 7.0, row * table.height() / 7.0, table.width() / 7.0, table.height() / 7.0);
+        // Not reaching into the next cells
+        const QRect pixels = QRectF(cell.topLeft() * image.devicePixelRatio(), cell.size() * image.devicePixelRatio()).toAlignedRect().adjusted(2, 2, -2, -2);
+
+        for (int y = pixels.top(); y <= pixels.bottom(); ++y) {
+            for (int x = pixels.left(); x <= pixels.right(); ++x) {
+                const QColor color = image.pixelColor(x, y);
+                if (backgrounds.contains(color)) {
+                    return color;
+                }
+            }
+        }
+        return QColor();
+    }
+
+    static void setupTable(TestDateTable &table)
+    {
+        table.setDate(MONTH);
+        table.resize(350, 350);
+    }
+
+private Q_SLOTS:
+    void testOverlappingRanges()
+    {
+        TestDateTable table;
+        setupTable(table);
+
+        table.setCustomDatePainting(day(5), day(20), Qt::white, KDateTable::RectangleMode, Qt::red);
+        // Splits the first range in two
+        table.setCustomDatePainting(day(10), day(15), Qt::white, KDateTable::RectangleMode, Qt::green);
+        // Cuts the end of the first range
+        table.setCustomDatePainting(day(18), day(25), Qt::white, KDateTable::RectangleMode, Qt::blue);
+
+        QCOMPARE(cellBackground(table, day(4)), QColor());
+        QCOMPARE(cellBackground(table, day(5)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(9)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(10)), QColor(Qt::green));
+        QCOMPARE(cellBackground(table, day(15)), QColor(Qt::green));
+        QCOMPARE(cellBackground(table, day(16)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(17)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(18)), QColor(Qt::blue));
+        QCOMPARE(cellBackground(table, day(25)), QColor(Qt::blue));
+        QCOMPARE(cellBackground(table, day(26)), QColor());
+
+        // Unsetting across two ranges keeps what is outside of it
+        table.unsetCustomDatePainting(day(8), day(12));
+        QCOMPARE(cellBackground(table, day(7)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(8)), QColor());
+        QCOMPARE(cellBackground(table, day(12)), QColor());
+        QCOMPARE(cellBackground(table, day(13)), QColor(Qt::green));
+
+        // A single date inside a range
+        table.setCustomDatePainting(day(14), Qt::white, KDateTable::RectangleMode, Qt::blue);
+        QCOMPARE(cellBackground(table, day(13)), QColor(Qt::green));
+        QCOMPARE(cellBackground(table, day(14)), QColor(Qt::blue));
+        QCOMPARE(cellBackground(table, day(15)), QColor(Qt::green));
+        table.unsetCustomDatePainting(day(14));
+        QCOMPARE(cellBackground(table, day(14)), QColor());
+        QCOMPARE(cellBackground(table, day(15)), QColor(Qt::green));
+
+        // A range covering others replaces them
+        table.setCustomDatePainting(day(3), day(27), Qt::white, KDateTable::RectangleMode, Qt::yellow);
+        QCOMPARE(cellBackground(table, day(3)), QColor(Qt::yellow));
+        QCOMPARE(cellBackground(table, day(13)), QColor(Qt::yellow));
+        QCOMPARE(cellBackground(table, day(27)), QColor(Qt::yellow));
+        QCOMPARE(cellBackground(table, day(28)), QColor());
+    }
+
+    void testWeekdays()
+    {
+        TestDateTable table;
+        setupTable(table);
+        QCOMPARE(day(9).dayOfWeek(), int(Qt::Monday));
+
+        table.setCustomWeekdayPainting(Qt::Monday, Qt::white, KDateTable::RectangleMode, Qt::red);
+        table.setCustomDatePainting(day(15), day(17), Qt::white, KDateTable::RectangleMode, Qt::green);
+        QCOMPARE(cellBackground(table, day(9)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(10)), QColor());
+        // Dates take precedence over weekdays
+        QCOMPARE(cellBackground(table, day(16)), QColor(Qt::green));
+
+        table.unsetCustomDatePainting(day(16));
+        QCOMPARE(cellBackground(table, day(16)), QColor(Qt::red));
+
+        table.clearCustomDatePainting();
+        QCOMPARE(cellBackground(table, day(9)), QColor());
+        QCOMPARE(cellBackground(table, day(15)), QColor());
+    }
+
+    void testBatchUpdate()
+    {
+        TestDateTable table;
+        setupTable(table);
+        table.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&table));
+        QTRY_VERIFY(table.paintCount > 0);
+        QCoreApplication::processEvents();
+        table.paintCount = 0;
+
+        table.beginCustomDatePaintingUpdate();
+        table.beginCustomDatePaintingUpdate();
+        for (int i = 5; i <= 25; ++i) {
+            table.setCustomDatePainting(day(i), Qt::white, KDateTable::RectangleMode, i % 2 ? Qt::red : Qt::green);
+        }
+        table.endCustomDatePaintingUpdate();
+        QCoreApplication::processEvents();
+        QCOMPARE(table.paintCount, 0);
+
+        // Only the outermost end repaints, once
+        table.endCustomDatePaintingUpdate();
+        QTRY_COMPARE(table.paintCount, 1);
+        QCoreApplication::processEvents();
+        QCOMPARE(table.paintCount, 1);
+
+        QCOMPARE(cellBackground(table, day(5)), QColor(Qt::red));
+        QCOMPARE(cellBackground(table, day(6)), QColor(Qt::green));
+        QCOMPARE(cellBackground(table, day(26)), QColor());
+
+        // Unbalanced ends are ignored
+        table.endCustomDatePaintingUpdate();
+        table.setCustomDatePainting(day(26), Qt::white, KDateTable::RectangleMode, Qt::blue);
+        QCOMPARE(cellBackground(table, day(26)), QColor(Qt::blue));
+    }
+};
+
+QTEST_MAIN(KDateTableAutoTest)
+
+#include "kdatetableautotest.moc"
@@ -0,0 +1,105 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KEditListWidget>
+
+#include <QLineEdit>
+#include <QListView>
+#include <QPushButton>
+#include <QTest>
+
+class KEditListWidgetTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void select(KEditListWidget &widget, int row)
+    {
+        QListView *view = widget.listView();
+        view->selectionModel()->setCurrentIndex(view->model()->index(row, 0), QItemSelectionModel::ClearAndSelect);
+    }
+
+    // With nothing selected, the add button is disabled for a text already in the list
+    static bool isDuplicate(KEditListWidget &widget, const QString &text)
+    {
+        widget.listView()->selectionModel()->clear();
+        widget.lineEdit()->setText(text);
+        return !widget.addButton()->isEnabled();
+    }
+
+private Q_SLOTS:
+    void testDuplicates()
+    {
+        KEditListWidget widget;
+        widget.setCheckAtEntering(true);
+        widget.setItems({QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")});
+        QVERIFY(isDuplicate(widget, QStringLiteral("b")));
+        QVERIFY(!isDuplicate(widget, QStringLiteral("d")));
+
+        // Typing over the selected entry
+        select(widget, 1);
+        QCOMPARE(widget.lineEdit()->text(), QStringLiteral("b"));
+        widget.lineEdit()->setText(QStringLiteral("x"));
+        QCOMPARE(widget.items(), (QStringList{QStringLiteral("a"), QStringLiteral("x"), QStringLiteral("c")}));
+        QVERIFY(!isDuplicate(widget, QStringLiteral("b")));
+        QVERIFY(isDuplicate(widget, QStringLiteral("x")));
+
+        // Moving it
+        select(widget, 1);
+        widget.upButton()->click();
+        QCOMPARE(widget.items(), (QStringList{QStringLiteral("x"), QStringLiteral("a"), QStringLiteral("c")}));
+        QVERIFY(isDuplicate(widget, QStringLiteral("x")));
+        QVERIFY(isDuplicate(widget, QStringLiteral("a")));
+
+        // Removing one of two equal entries keeps the other
+        widget.insertItem(QStringLiteral("c"));
+        select(widget, 3);
+        widget.removeButton()->click();
+        QCOMPARE(widget.items(), (QStringList{QStringLiteral("x"), QStringLiteral("a"), QStringLiteral("c")}));
+        QVERIFY(isDuplicate(widget, QStringLiteral("c")));
+
+        // Removing it
+        select(widget, 0);
+        widget.removeButton()->click();
+        QCOMPARE(widget.items(), (QStringList{QStringLiteral("a"), QStringLiteral("c")}));
+        QVERIFY(!isDuplicate(widget, QStringLiteral("x")));
+
+        // Adding
+        QVERIFY(!isDuplicate(widget, QStringLiteral("y")));
+        widget.addButton()->click();
+        QCOMPARE(widget.items(), (QStringList{QStringLiteral("y"), QStringLiteral("a"), QStringLiteral("c")}));
+        QVERIFY(isDuplicate(widget, QStringLiteral("y")));
+
+        // Changes made to the model directly
+        widget.listView()->model()->setData(widget.listView()->model()->index(0, 0), QStringLiteral("z"));
+        QVERIFY(!isDuplicate(widget, QStringLiteral("y")));
+        QVERIFY(isDuplicate(widget, QStringLiteral("z")));
+        widget.setItems({QStringLiteral("b")});
+        QVERIFY(!isDuplicate(widget, QStringLiteral("z")));
+        QVERIFY(isDuplicate(widget, QStringLiteral("b")));
+    }
+
+    void testInsertClearsSelection()
+    {
+        KEditListWidget widget;
+        widget.setItems({QStringLiteral("a"), QStringLiteral("b")});
+        select(widget, 1);
+        QCOMPARE(widget.currentItem(), 1);
+
+        widget.insertItem(QStringLiteral("c"), 0);
+        QCOMPARE(widget.items(), (QStringList{QStringLiteral("c"), QStringLiteral("a"), QStringLiteral("b")}));
+        QCOMPARE(widget.currentItem(), -1);
+
+        select(widget, 1);
+        widget.insertStringList({QStringLiteral("d")});
+        QCOMPARE(widget.currentItem(), -1);
+    }
+};
+
+QTEST_MAIN(KEditListWidgetTest)
+
+#include "keditlistwidgettest.moc"
@@ -0,0 +1,191 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KRecentFilesMenu>
+
+#include <QAction>
+#include <QDir>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+#include <memory>
+
+static QUrl url(const char *name)
+{
+    return QUrl::fromLocalFile(QStringLiteral("/tmp/") + QString::fromLatin1(name));
+}
+
+class KRecentFilesMenuTest : public QObject
+{
+    Q_OBJECT
+
+    // Menus write their changes in the background, every test uses its own group
+    static QString group()
+    {
+        return QString::fromLatin1(QTest::currentTestFunction());
+    }
+
+    static QString fileName()
+    {
+        return QStringLiteral("%1/%2_recentfiles").arg(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation), QCoreApplication::applicationName());
+    }
+
+    // What is in the file for the group of the test
+    static QList<QUrl> storedUrls()
+    {
+        QList<QUrl> urls;
+        QSettings settings(fileName(), QSettings::IniFormat);
+        settings.beginGroup(group());
+        const int size = settings.beginReadArray(QStringLiteral("files"));
+        for (int i = 0; i < size; ++i) {
+            settings.setArrayIndex(i);
+            urls.append(settings.value(QStringLiteral("url")).toUrl());
+        }
+        settings.endArray();
+        settings.endGroup();
+        return urls;
+    }
+
+    static QStringList actionTexts(const KRecentFilesMenu &menu)
+    {
+        QStringList texts;
+        const QList<QAction *> actions = menu.actions();
+        for (const QAction *action : actions) {
+            texts.append(action->text());
+        }
+        return texts;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        QFile::remove(fileName());
+        QDir().mkpath(QFileInfo(fileName()).absolutePath());
+    }
+
+    void testMenusShareEntries()
+    {
+        KRecentFilesMenu menu1;
+        KRecentFilesMenu menu2;
+        menu1.setGroup(group());
+        menu2.setGroup(group());
+        QSignalSpy changedSpy(&menu2, &KRecentFilesMenu::recentFilesChanged);
+
+        menu1.addUrl(url("a"));
+        menu1.addUrl(url("b"));
+        QCOMPARE(changedSpy.count(), 2);
+        QCOMPARE(menu2.recentFiles(), (QList<QUrl>{url("b"), url("a")}));
+
+        menu2.removeUrl(url("b"));
+        QCOMPARE(menu1.recentFiles(), QList<QUrl>{url("a")});
+
+        menu2.clearRecentFiles();
+        QVERIFY(menu1.recentFiles().isEmpty());
+        QCOMPARE(changedSpy.count(), 4);
+    }
+
+    void testLargestMaximumItems()
+    {
+        KRecentFilesMenu small;
+        auto large = std::make_unique<KRecentFilesMenu>();
+        small.setGroup(group());
+        large->setGroup(group());
+        small.setMaximumItems(2);
+        large->setMaximumItems(4);
+
+        for (const char *name : {"a", "b", "c", "d", "e"}) {
+            small.addUrl(url(name));
+        }
+        QCOMPARE(small.recentFiles(), (QList<QUrl>{url("e"), url("d")}));
+        QCOMPARE(large->recentFiles(), (QList<QUrl>{url("e"), url("d"), url("c"), url("b")}));
+
+        // Lowering the maximum of one menu keeps the entries of the other
+        large->setMaximumItems(3);
+        QCOMPARE(large->recentFiles(), (QList<QUrl>{url("e"), url("d"), url("c")}));
+
+        // Without the larger menu, the entries are kept up to the maximum of the remaining one
+        large.reset();
+        small.addUrl(url("f"));
+        KRecentFilesMenu later;
+        later.setGroup(group());
+        QCOMPARE(later.recentFiles(), (QList<QUrl>{url("f"), url("e")}));
+    }
+
+    void testReadFromFile()
+    {
+        KRecentFilesMenu menu;
+        menu.setGroup(group());
+        QVERIFY(menu.recentFiles().isEmpty());
+
+        // Written by another process
+        {
+            QSettings settings(fileName(), QSettings::IniFormat);
+            settings.beginGroup(group());
+            settings.beginWriteArray(QStringLiteral("files"));
+            settings.setArrayIndex(0);
+            settings.setValue(QStringLiteral("url"), url("a"));
+            settings.setValue(QStringLiteral("displayName"), QStringLiteral("a"));
+            settings.endArray();
+            settings.endGroup();
+        }
+
+        // Setting the group reads the file again, instead of waiting for the file watcher
+        menu.setGroup(group());
+        QCOMPARE(menu.recentFiles(), QList<QUrl>{url("a")});
+    }
+
+    void testActions()
+    {
+        // The actions are there without showing the menu
+        KRecentFilesMenu menu;
+        menu.setGroup(group());
+        QVERIFY(!menu.isEmpty());
+        QCOMPARE(actionTexts(menu), QStringList{QStringLiteral("No Entries")});
+
+        menu.addUrl(url("a"));
+        menu.addUrl(url("b"));
+        QCOMPARE(menu.actions().size(), 4);
+        QVERIFY(menu.actions().at(0)->text().startsWith(QLatin1String("b [")));
+        QVERIFY(menu.actions().at(1)->text().startsWith(QLatin1String("a [")));
+        QVERIFY(menu.actions().at(2)->isSeparator());
+        QCOMPARE(menu.actions().at(3)->text(), QStringLiteral("Clear List"));
+
+        // Entries which did not change keep their actions
+        QAction *action = menu.actions().at(1);
+        menu.addUrl(url("c"));
+        QCOMPARE(menu.actions().at(2), action);
+
+        QSignalSpy triggeredSpy(&menu, &KRecentFilesMenu::urlTriggered);
+        action->trigger();
+        QCOMPARE(triggeredSpy.count(), 1);
+        QCOMPARE(triggeredSpy.at(0).at(0).toUrl(), url("a"));
+
+        menu.actions().constLast()->trigger();
+        QVERIFY(menu.recentFiles().isEmpty());
+        QCOMPARE(actionTexts(menu), QStringList{QStringLiteral("No Entries")});
+    }
+
+    void testWriteOnDestruction()
+    {
+        {
+            KRecentFilesMenu menu;
+            menu.setGroup(group());
+            menu.addUrl(url("a"));
+            menu.addUrl(url("b"));
+        }
+
+        // Written before the menu is gone
+        QCOMPARE(storedUrls(), (QList<QUrl>{url("b"), url("a")}));
+    }
+};
+
+QTEST_MAIN(KRecentFilesMenuTest)
+
+#include "krecentfilesmenutest.moc"
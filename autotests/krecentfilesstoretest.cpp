@@ -0,0 +1,216 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "krecentfilesstore_p.h"
+
+#include <QDir>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+#include <limits>
+
+using Entry = KRecentFilesStore::Entry;
+using Change = KRecentFilesStore::Change;
+
+static Entry entry(const char *name)
+{
+    const QString fileName = QString::fromLatin1(name);
+    return {QUrl::fromLocalFile(QStringLiteral("/tmp/") + fileName), fileName};
+}
+
+class KRecentFilesStoreTest : public QObject
+{
+    Q_OBJECT
+
+    // Stores write their pending changes in the background when destroyed,
+    // so every test uses its own file in a directory that is kept
+    QString fileName(const QString &name = QString()) const
+    {
+        return m_directory + QLatin1Char('/') + (name.isEmpty() ? QString::fromLatin1(QTest::currentTestFunction()) : name);
+    }
+
+    QList<QUrl> storedUrls(const QString &group) const
+    {
+        QList<QUrl> urls;
+        QSettings settings(fileName(), QSettings::IniFormat);
+        settings.beginGroup(group);
+        const int size = settings.beginReadArray(QStringLiteral("files"));
+        for (int i = 0; i < size; ++i) {
+            settings.setArrayIndex(i);
+            urls.append(settings.value(QStringLiteral("url")).toUrl());
+        }
+        settings.endArray();
+        settings.endGroup();
+        return urls;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        m_directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QLatin1String("/krecentfilesstoretest");
+        QDir(m_directory).removeRecursively();
+        QDir().mkpath(m_directory);
+    }
+
+    void testApplyChanges_data()
+    {
+        QTest::addColumn<QList<Entry>>("entries");
+        QTest::addColumn<QList<Change>>("changes");
+        QTest::addColumn<QList<Entry>>("expected");
+
+        const Entry a = entry("a");
+        const Entry b = entry("b");
+        const Entry c = entry("c");
+        const Entry d = entry("d");
+
+        QTest::newRow("add") << QList<Entry>{b, c} << QList<Change>{{Change::Add, a, 10}} << QList<Entry>{a, b, c};
+        QTest::newRow("add existing") << QList<Entry>{a, b, c} << QList<Change>{{Change::Add, c, 10}} << QList<Entry>{c, a, b};
+        QTest::newRow("add renamed") << QList<Entry>{a, b} << QList<Change>{{Change::Add, {b.url, QStringLiteral("renamed")}, 10}}
+                                     << QList<Entry>{{b.url, QStringLiteral("renamed")}, a};
+        QTest::newRow("add past maximum") << QList<Entry>{b, c, d} << QList<Change>{{Change::Add, a, 2}} << QList<Entry>{a, b};
+        QTest::newRow("remove") << QList<Entry>{a, b, c} << QList<Change>{{Change::Remove, {b.url, QString()}}} << QList<Entry>{a, c};
+        QTest::newRow("remove missing") << QList<Entry>{a, c} << QList<Change>{{Change::Remove, {b.url, QString()}}} << QList<Entry>{a, c};
+        QTest::newRow("clear") << QList<Entry>{a, b, c} << QList<Change>{{Change::Clear, {}}} << QList<Entry>{};
+        QTest::newRow("truncate") << QList<Entry>{a, b, c} << QList<Change>{{Change::Truncate, {}, 1}} << QList<Entry>{a};
+        QTest::newRow("truncate short") << QList<Entry>{a, b} << QList<Change>{{Change::Truncate, {}, 5}} << QList<Entry>{a, b};
+        QTest::newRow("in order") << QList<Entry>{a} << QList<Change>{{Change::Add, b, 10}, {Change::Clear, {}}, {Change::Add, c, 10}, {Change::Add, d, 10}}
+                                  << QList<Entry>{d, c};
+        // Replayed on top of what another process wrote in the meantime
+        QTest::newRow("merge") << QList<Entry>{c, d, b} << QList<Change>{{Change::Add, a, 10}, {Change::Remove, {d.url, QString()}}}
+                               << QList<Entry>{a, c, b};
+    }
+
+    void testApplyChanges()
+    {
+        QFETCH(QList<Entry>, entries);
+        QFETCH(QList<Change>, changes);
+        QFETCH(QList<Entry>, expected);
+
+        QCOMPARE(KRecentFilesStore::applyChanges(entries, changes), expected);
+    }
+
+    void testForFile()
+    {
+        std::shared_ptr<KRecentFilesStore> store = KRecentFilesStore::forFile(fileName());
+        QCOMPARE(KRecentFilesStore::forFile(fileName()), store);
+        QVERIFY(KRecentFilesStore::forFile(fileName(QStringLiteral("other"))) != store);
+    }
+
+    void testLargestMaximumItems()
+    {
+        std::shared_ptr<KRecentFilesStore> store = KRecentFilesStore::forFile(fileName());
+        const QString group = QStringLiteral("RecentFiles");
+        QObject small;
+        QObject large;
+        QObject otherGroup;
+
+        QCOMPARE(store->maximumItems(group), std::numeric_limits<qsizetype>::max());
+
+        store->setMaximumItems(&small, group, 2);
+        store->setMaximumItems(&large, group, 3);
+        store->setMaximumItems(&otherGroup, QStringLiteral("Other"), 10);
+        QCOMPARE(store->maximumItems(group), qsizetype(3));
+
+        QSignalSpy changedSpy(store.get(), &KRecentFilesStore::changed);
+        for (const char *name : {"a", "b", "c", "d"}) {
+            store->addUrl(group, entry(name));
+        }
+        QCOMPARE(changedSpy.count(), 4);
+        QCOMPARE(changedSpy.at(0).at(0).toString(), group);
+        QCOMPARE(store->entries(group), (QList<Entry>{entry("d"), entry("c"), entry("b")}));
+
+        // Once the larger menu is gone, the smaller one sets the limit
+        store->removeMenu(&large);
+        QCOMPARE(store->maximumItems(group), qsizetype(2));
+        store->truncate(group);
+        QCOMPARE(store->entries(group), (QList<Entry>{entry("d"), entry("c")}));
+
+        store->removeUrl(group, entry("d").url);
+        QCOMPARE(store->entries(group), (QList<Entry>{entry("c")}));
+        store->clear(group);
+        QVERIFY(store->entries(group).isEmpty());
+    }
+
+    void testReload()
+    {
+        std::shared_ptr<KRecentFilesStore> store = KRecentFilesStore::forFile(fileName());
+        const QString group = QStringLiteral("RecentFiles");
+        store->addUrl(group, entry("a"));
+
+        // Written by another process
+        {
+            QSettings settings(fileName(), QSettings::IniFormat);
+            settings.beginGroup(group);
+            settings.beginWriteArray(QStringLiteral("files"));
+            settings.setArrayIndex(0);
+            settings.setValue(QStringLiteral("url"), entry("b").url);
+            settings.setValue(QStringLiteral("displayName"), entry("b").displayName);
+            settings.endArray();
+            settings.endGroup();
+        }
+
+        // The change not written yet is kept on top of what was read
+        store->reload(group);
+        QCOMPARE(store->entries(group), (QList<Entry>{entry("a"), entry("b")}));
+    }
+
+    void testDelayedWrite()
+    {
+        std::shared_ptr<KRecentFilesStore> store = KRecentFilesStore::forFile(fileName());
+        const QString group = QStringLiteral("RecentFiles");
+
+        // A burst of changes is written once, after a delay
+        for (const char *name : {"a", "b", "c"}) {
+            store->addUrl(group, entry(name));
+        }
+        QVERIFY(storedUrls(group).isEmpty());
+        QTRY_COMPARE(storedUrls(group), (QList<QUrl>{entry("c").url, entry("b").url, entry("a").url}));
+
+        // Flushing writes the changes without waiting
+        store->removeUrl(group, entry("b").url);
+        store->flush();
+        QTRY_COMPARE(storedUrls(group), (QList<QUrl>{entry("c").url, entry("a").url}));
+        QCOMPARE(store->entries(group), (QList<Entry>{entry("c"), entry("a")}));
+    }
+
+    void testWriteNow()
+    {
+        std::shared_ptr<KRecentFilesStore> store = KRecentFilesStore::forFile(fileName());
+        const QString group = QStringLiteral("RecentFiles");
+        store->addUrl(group, entry("a"));
+        store->flush();
+        // Possibly while the first write still runs
+        store->addUrl(group, entry("b"));
+        store->writeNow();
+        QCOMPARE(storedUrls(group), (QList<QUrl>{entry("b").url, entry("a").url}));
+
+        store->writeNow();
+        QCOMPARE(store->entries(group), (QList<Entry>{entry("b"), entry("a")}));
+    }
+
+    void testWriteOnDestruction()
+    {
+        std::shared_ptr<KRecentFilesStore> store = KRecentFilesStore::forFile(fileName());
+        const QString group = QStringLiteral("RecentFiles");
+        store->addUrl(group, entry("a"));
+        QVERIFY(storedUrls(group).isEmpty());
+
+        // Written in the background by the last user of the store
+        store.reset();
+        QTRY_COMPARE(storedUrls(group), QList<QUrl>{entry("a").url});
+    }
+
+private:
+    QString m_directory;
+};
+
+QTEST_GUILESS_MAIN(KRecentFilesStoreTest)
+
+#include "krecentfilesstoretest.moc"
@@ -7,8 +7,8 @@
 
 #include "kselectaction_unittest.h"
 #include <QComboBox>
+#include <QLineEdit>
 #include <QMainWindow>
-#include <QStandardItemModel>
 #include <QTest>
 #include <QToolBar>
 #include <kselectaction.h>
@@ -175,10 +175,9 @@ void KSelectAction_UnitTest::testChildActionStateChangeComboMode()
     QAction *childAction = selectAction.addAction(itemText);
     QCOMPARE(comboBox->itemText(0), itemText);
     childAction->setEnabled(false);
-    // There's no API for item-is-enabled, need to go via the internal model like kselectaction does...
-    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(comboBox->model());
-    QVERIFY(model);
-    QVERIFY(!model->item(0)->isEnabled());
+    // There's no API for item-is-enabled, need to go via the model shared by the combo boxes...
+    const QAbstractItemModel *model = comboBox->model();
+    QVERIFY(!(model->flags(model->index(0, 0)) & Qt::ItemIsEnabled));
 
     // Now remove the action
     selectAction.removeAction(childAction);
@@ -349,4 +348,135 @@ void KSelectAction_UnitTest::testRequestWidgetMenuModeWidgetParentRemoveActions(
     QCOMPARE(widget->actions().at(0)->text(), QStringLiteral("selectAction"));
 }
 
+void KSelectAction_UnitTest::testActionByText()
+{
+    KSelectAction selectAction(QStringLiteral("selectAction"), nullptr);
+    selectAction.setItems({QStringLiteral("Alpha"), QStringLiteral("&Beta"), QStringLiteral("alpha")});
+
+    QAction *alpha = selectAction.action(0);
+    QAction *beta = selectAction.action(1);
+    QAction *lowerAlpha = selectAction.action(2);
+    QCOMPARE(selectAction.action(QStringLiteral("Alpha")), alpha);
+    QCOMPARE(selectAction.action(QStringLiteral("alpha")), lowerAlpha);
+    QCOMPARE(selectAction.action(QStringLiteral("ALPHA"), Qt::CaseInsensitive), alpha);
+    QCOMPARE(selectAction.action(QStringLiteral("Beta")), beta);
+    QCOMPARE(selectAction.action(QStringLiteral("Gamma")), nullptr);
+
+    selectAction.changeItem(1, QStringLiteral("Gamma"));
+    QCOMPARE(selectAction.action(QStringLiteral("Beta")), nullptr);
+    QCOMPARE(selectAction.action(QStringLiteral("Gamma")), beta);
+
+    beta->setText(QStringLiteral("Delta"));
+    QCOMPARE(selectAction.action(QStringLiteral("Delta")), beta);
+
+    selectAction.removeAction(alpha);
+    delete alpha;
+    QCOMPARE(selectAction.action(QStringLiteral("ALPHA"), Qt::CaseInsensitive), lowerAlpha);
+
+    QVERIFY(selectAction.setCurrentAction(QStringLiteral("Delta")));
+    QCOMPARE(selectAction.currentAction(), beta);
+}
+
+void KSelectAction_UnitTest::testSetItemsComboMode()
+{
+    KSelectAction selectAction(QStringLiteral("selectAction"), nullptr);
+    selectAction.setToolBarMode(KSelectAction::ComboBoxMode);
+    QWidget parent;
+    QComboBox *comboBox = qobject_cast<QComboBox *>(selectAction.requestWidget(&parent));
+    QVERIFY(comboBox);
+
+    selectAction.setItems({QStringLiteral("one"), QStringLiteral("two"), QStringLiteral("three")});
+    QCOMPARE(comboBox->count(), 3);
+    QCOMPARE(comboBox->itemText(2), QStringLiteral("three"));
+    QVERIFY(comboBox->isEnabled());
+
+    selectAction.setCurrentItem(1);
+    QCOMPARE(comboBox->currentIndex(), 1);
+
+    selectAction.setItems({QStringLiteral("four")});
+    QCOMPARE(comboBox->count(), 1);
+    QCOMPARE(comboBox->itemText(0), QStringLiteral("four"));
+
+    // Changes after setItems() are still mirrored per action
+    selectAction.addAction(QStringLiteral("five"));
+    QCOMPARE(comboBox->count(), 2);
+    QAction *four = selectAction.removeAction(selectAction.action(0));
+    delete four;
+    QCOMPARE(comboBox->count(), 1);
+    QCOMPARE(comboBox->itemText(0), QStringLiteral("five"));
+}
+
+void KSelectAction_UnitTest::testDeleteActionComboMode()
+{
+    QMainWindow mainWindow;
+    auto selectAction = new KSelectAction(QStringLiteral("selectAction"), &mainWindow);
+    selectAction->setToolBarMode(KSelectAction::ComboBoxMode);
+    selectAction->setItems({QStringLiteral("one"), QStringLiteral("two"), QStringLiteral("three")});
+    selectAction->setCurrentItem(2);
+
+    QToolBar *toolBar = mainWindow.addToolBar(QStringLiteral("Test"));
+    toolBar->addAction(selectAction);
+    QComboBox *comboBox = qobject_cast<QComboBox *>(toolBar->widgetForAction(selectAction));
+    QVERIFY(comboBox);
+    mainWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&mainWindow));
+
+    // Deleted without removeAction(), the combo box must not keep showing it
+    delete selectAction->action(1);
+    QCOMPARE(comboBox->count(), 2);
+    QCOMPARE(comboBox->itemText(0), QStringLiteral("one"));
+    QCOMPARE(comboBox->itemText(1), QStringLiteral("three"));
+    QCOMPARE(comboBox->currentIndex(), 1);
+    QVERIFY(comboBox->model()->flags(comboBox->model()->index(1, 0)) & Qt::ItemIsEnabled);
+
+    // Repainting reads all rows from the model
+    comboBox->repaint();
+    comboBox->showPopup();
+    comboBox->hidePopup();
+}
+
+void KSelectAction_UnitTest::testTypeExistingItemComboMode()
+{
+    KSelectAction selectAction(QStringLiteral("selectAction"), nullptr);
+    selectAction.setToolBarMode(KSelectAction::ComboBoxMode);
+    selectAction.setEditable(true);
+    selectAction.setItems({QStringLiteral("Alpha"), QStringLiteral("Beta")});
+
+    QWidget parent;
+    QComboBox *comboBox = qobject_cast<QComboBox *>(selectAction.requestWidget(&parent));
+    QVERIFY(comboBox);
+    QVERIFY(comboBox->lineEdit());
+
+    // A case variant of an existing item selects it, like QComboBox does, rather than adding a duplicate
+    comboBox->lineEdit()->setText(QStringLiteral("beta"));
+    QTest::keyClick(comboBox->lineEdit(), Qt::Key_Return);
+    QCOMPARE(selectAction.actions().count(), 2);
+    QCOMPARE(comboBox->count(), 2);
+
+    comboBox->lineEdit()->setText(QStringLiteral("Gamma"));
+    QTest::keyClick(comboBox->lineEdit(), Qt::Key_Return);
+    QCOMPARE(selectAction.actions().count(), 3);
+    QCOMPARE(selectAction.currentText(), QStringLiteral("Gamma"));
+    QCOMPARE(comboBox->currentIndex(), 2);
+}
+
+void KSelectAction_UnitTest::testInsertExistingActionComboMode()
+{
+    KSelectAction selectAction(QStringLiteral("selectAction"), nullptr);
+    selectAction.setToolBarMode(KSelectAction::ComboBoxMode);
+    selectAction.setItems({QStringLiteral("one"), QStringLiteral("two")});
+
+    QWidget parent;
+    QComboBox *comboBox = qobject_cast<QComboBox *>(selectAction.requestWidget(&parent));
+    QVERIFY(comboBox);
+
+    // Adding an action again does not add a second row for it
+    selectAction.addAction(selectAction.action(0));
+    selectAction.insertAction(selectAction.action(0), selectAction.action(1));
+    QCOMPARE(selectAction.actions().count(), 2);
+    QCOMPARE(comboBox->count(), 2);
+    QCOMPARE(comboBox->itemText(0), QStringLiteral("one"));
+    QCOMPARE(comboBox->itemText(1), QStringLiteral("two"));
+}
+
 #include "moc_kselectaction_unittest.cpp"
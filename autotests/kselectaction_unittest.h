@@ -40,6 +40,12 @@ private Q_SLOTS:
     void testRequestWidgetMenuModeWidgetParentSeveralActions();
     void testRequestWidgetMenuModeWidgetParentAddActions();
     void testRequestWidgetMenuModeWidgetParentRemoveActions();
+
+    void testActionByText();
+    void testSetItemsComboMode();
+    void testDeleteActionComboMode();
+    void testTypeExistingItemComboMode();
+    void testInsertExistingActionComboMode();
 };
 
 #endif
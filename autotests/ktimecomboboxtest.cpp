@@ -155,6 +155,28 @@ void KTimeComboBoxTest::testTimeList()
     delete m_combo;
 }
 
+void KTimeComboBoxTest::testForceTime()
+{
+    m_combo = new KTimeComboBox();
+    m_combo->setOptions(m_combo->options() | KTimeComboBox::ForceTime);
+    // Times are rounded up to the next one of the list
+    m_combo->setTime(QTime(10, 7, 0));
+    QCOMPARE(m_combo->time(), QTime(10, 15, 0));
+    m_combo->setTime(QTime(10, 15, 0));
+    QCOMPARE(m_combo->time(), QTime(10, 15, 0));
+    m_combo->setTime(QTime(23, 50, 0));
+    QCOMPARE(m_combo->time(), QTime(23, 59, 59, 999));
+
+    // One minute intervals, every entry of the day
+    m_combo->setTimeListInterval(1);
+    QCOMPARE(m_combo->count(), 1441);
+    QCOMPARE(m_combo->itemData(600).toTime(), QTime(10, 0, 0));
+    m_combo->setTime(QTime(10, 0, 20));
+    QCOMPARE(m_combo->time(), QTime(10, 1, 0));
+    QCOMPARE(m_combo->currentIndex(), 601);
+    delete m_combo;
+}
+
 void KTimeComboBoxTest::testOptions()
 {
     m_combo = new KTimeComboBox();
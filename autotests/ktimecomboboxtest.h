@@ -24,6 +24,7 @@ private Q_SLOTS:
     void testTimeRange();
     void testTimeListInterval();
     void testTimeList();
+    void testForceTime();
     void testOptions();
     void testDisplayFormat();
     void testMask();
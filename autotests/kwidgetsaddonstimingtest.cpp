@@ -0,0 +1,94 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <kdatepicker.h>
+#include <kratingpainter.h>
+#include <kwidgetsaddonstiming.h>
+
+#include <QImage>
+#include <QPainter>
+#include <QTest>
+
+#include <numeric>
+
+class KWidgetsAddonsTimingTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void paintRating()
+    {
+        QImage image(100, 20, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        KRatingPainter().paint(&painter, image.rect(), 5);
+    }
+
+    static KWidgetsAddonsTiming::Statistics find(const QByteArray &className, KWidgetsAddonsTiming::Operation operation)
+    {
+        const QList<KWidgetsAddonsTiming::Statistics> statistics = KWidgetsAddonsTiming::statistics();
+        for (const KWidgetsAddonsTiming::Statistics &entry : statistics) {
+            if (entry.className() == className && entry.operation() == operation) {
+                return entry;
+            }
+        }
+        return {};
+    }
+
+private Q_SLOTS:
+    void init()
+    {
+        KWidgetsAddonsTiming::setEnabled(false);
+        KWidgetsAddonsTiming::reset();
+    }
+
+    void testDisabled()
+    {
+        QVERIFY(!KWidgetsAddonsTiming::isEnabled());
+        paintRating();
+        QVERIFY(KWidgetsAddonsTiming::statistics().isEmpty());
+        QVERIFY(KWidgetsAddonsTiming::report().isEmpty());
+    }
+
+    void testRecord()
+    {
+        KWidgetsAddonsTiming::setEnabled(true);
+        paintRating();
+        paintRating();
+
+        const KWidgetsAddonsTiming::Statistics statistics = find("KRatingPainter", KWidgetsAddonsTiming::Paint);
+        QCOMPARE(statistics.count(), qint64(2));
+        QVERIFY(statistics.totalNsecs() > 0);
+        QVERIFY(statistics.maximumNsecs() <= statistics.totalNsecs());
+        const QList<qint64> histogram = statistics.histogram();
+        QCOMPARE(histogram.size(), qsizetype(KWidgetsAddonsTiming::HistogramSize));
+        QCOMPARE(std::accumulate(histogram.cbegin(), histogram.cend(), qint64(0)), qint64(2));
+        QVERIFY(KWidgetsAddonsTiming::report().contains(QLatin1String("KRatingPainter paint: 2 calls")));
+
+        // What was returned is not changed by recording more
+        paintRating();
+        QCOMPARE(statistics.count(), qint64(2));
+        QCOMPARE(find("KRatingPainter", KWidgetsAddonsTiming::Paint).count(), qint64(3));
+
+        KWidgetsAddonsTiming::reset();
+        QVERIFY(KWidgetsAddonsTiming::statistics().isEmpty());
+    }
+
+    void testWidgetPaint()
+    {
+        KWidgetsAddonsTiming::setEnabled(true);
+        KDatePicker picker;
+        picker.resize(picker.sizeHint());
+        picker.grab();
+
+        QVERIFY(find("KDateTable", KWidgetsAddonsTiming::Paint).count() > 0);
+    }
+};
+
+QTEST_MAIN(KWidgetsAddonsTimingTest)
+
+#include "kwidgetsaddonstimingtest.moc"
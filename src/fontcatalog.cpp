@@ -0,0 +1,161 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "fontcatalog_p.h"
+
+#include <QCoreApplication>
+#include <QFontDatabase>
+#include <QGlobalStatic>
+#include <QGuiApplication>
+
+#include <algorithm>
+
+// When message extraction needs to be avoided.
+#define TR_NOX(text, comment) QCoreApplication::translate("KFontChooser", text, comment)
+
+Q_GLOBAL_STATIC(KFontCatalog, s_fontCatalog)
+
+static bool isDefaultFontStyleName(const QString &style)
+{
+    /* clang-format off */
+    // Ordered by commonness, i.e. "Regular" is the most common
+    return style == QLatin1String("Regular")
+        || style == QLatin1String("Normal")
+        || style == QLatin1String("Book")
+        || style == QLatin1String("Roman");
+    /* clang-format on */
+}
+
+KFontCatalog::KFontCatalog()
+{
+    if (qGuiApp) {
+        connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, this, &KFontCatalog::clear);
+    }
+}
+
+KFontCatalog *KFontCatalog::self()
+{
+    return s_fontCatalog();
+}
+
+QList<KFontCatalog::Style> KFontCatalog::styles(const QString &family)
+{
+    auto it = m_styles.constFind(family);
+    if (it == m_styles.cend()) {
+        it = m_styles.insert(family, resolveStyles(family));
+    }
+
+    // Translated here rather than cached, translations can change while the styles do not
+    QList<Style> result;
+    result.reserve(it->size());
+    for (const Style &style : *it) {
+        const QString text = QCoreApplication::translate("KFontChooser", "%1", "@item Font style").arg(style.name);
+        const bool duplicate = std::any_of(result.cbegin(), result.cend(), [&text](const Style &s) {
+            return s.text == text;
+        });
+        if (!duplicate) {
+            result.append({text, style.name, style.identifier});
+        }
+    }
+    return result;
+}
+
+QList<KFontCatalog::Style> KFontCatalog::resolveStyles(const QString &family)
+{
+    // Get the list of styles available in this family.
+    QStringList styles = QFontDatabase::styles(family);
+    if (styles.isEmpty()) {
+        // Avoid extraction, it is in kdeqt.po
+        styles.append(TR_NOX("Normal", "QFontDatabase"));
+    }
+
+    // Always prepend Regular, Normal, Book or Roman, this way if the selected
+    // style is empty, selecting index 0 should work better
+    std::sort(styles.begin(), styles.end(), [](const QString &a, const QString &b) {
+        if (isDefaultFontStyleName(a)) {
+            return true;
+        } else if (isDefaultFontStyleName(b)) {
+            return false;
+        }
+        return false;
+    });
+
+    QList<Style> result;
+    result.reserve(styles.size());
+    for (const QString &style : std::as_const(styles)) {
+        // Sometimes the font database will report an invalid style,
+        // that falls back back to another when set.
+        // Remove such styles, by checking set/get round-trip.
+        const QFont testFont = QFontDatabase::font(family, style, 10);
+        if (QFontDatabase::styleString(testFont) != style) {
+            continue;
+        }
+
+        result.append({QString(), style, styleIdentifier(testFont)});
+    }
+    return result;
+}
+
+KFontCatalog::Sizes KFontCatalog::sizes(const QString &family, const QString &style)
+{
+    const auto key = std::make_pair(family, style);
+    auto it = m_sizes.constFind(key);
+    if (it != m_sizes.cend()) {
+        return *it;
+    }
+
+    Sizes result;
+    result.smoothlyScalable = QFontDatabase::isSmoothlyScalable(family, style);
+    if (!result.smoothlyScalable) {
+        const QList<int> smoothSizes = QFontDatabase::smoothSizes(family, style);
+        result.sizes.reserve(smoothSizes.size());
+        for (int size : smoothSizes) {
+            result.sizes.append(size);
+        }
+    }
+
+    m_sizes.insert(key, result);
+    return result;
+}
+
+QString KFontCatalog::styleIdentifier(const QFont &font)
+{
+    const int weight = font.weight();
+    QString styleName = font.styleName();
+    // If the styleName property is empty and the weight is QFont::Normal, that
+    // could mean it's a "Regular"-like style with the styleName part stripped
+    // so that subsequent calls to setBold(true) can work properly (i.e. selecting
+    // the "Bold" style provided by the font itself) without resorting to font
+    // "emboldening" which looks ugly.
+    // See also KConfigGroupGui::writeEntryGui().
+    if (styleName.isEmpty() && weight == QFont::Normal) {
+        const QStringList styles = QFontDatabase::styles(font.family());
+        for (const QString &style : styles) {
+            if (isDefaultFontStyleName(style)) {
+                styleName = style;
+                break;
+            } else {
+                // nothing more we can do
+            }
+        }
+    }
+
+    const QChar comma(QLatin1Char(','));
+    return QString::number(weight) + comma //
+        + QString::number((int)font.style()) + comma //
+        + QString::number(font.stretch()) + comma //
+        + styleName;
+}
+
+void KFontCatalog::clear()
+{
+    m_styles.clear();
+    m_sizes.clear();
+    Q_EMIT changed();
+}
+
+#include "moc_fontcatalog_p.cpp"
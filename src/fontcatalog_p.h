@@ -0,0 +1,88 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef FONTCATALOG_P_H
+#define FONTCATALOG_P_H
+
+#include <QFont>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include <utility>
+
+/*!
+ * \internal
+ *
+ * Process-wide cache of font database queries, shared by the KFont* widgets.
+ *
+ * Resolving the usable styles of a family requires a QFontDatabase::font()
+ * round trip per style, which is slow for families with many styles.
+ * The results only change when the font database does, so they are
+ * computed once per family and dropped on QGuiApplication::fontDatabaseChanged().
+ * The style texts are translated on every call, so they follow the language.
+ */
+class KFontCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Style {
+        QString text; // translated, as shown to the user
+        QString name; // as reported by QFontDatabase
+        QString identifier; // see styleIdentifier()
+    };
+
+    struct Sizes {
+        bool smoothlyScalable = true;
+        // Available sizes, only filled for fonts which are not smoothly scalable
+        QList<qreal> sizes;
+    };
+
+    KFontCatalog();
+
+    static KFontCatalog *self();
+
+    /*!
+     * Returns the valid styles of \a family, with the default style first
+     * and duplicates removed.
+     */
+    QList<Style> styles(const QString &family);
+
+    /*!
+     * Returns the size information for \a family in \a style.
+     */
+    Sizes sizes(const QString &family, const QString &style);
+
+    bool isSmoothlyScalable(const QString &family, const QString &style)
+    {
+        return sizes(family, style).smoothlyScalable;
+    }
+
+    // Human-readable style identifiers returned by QFontDatabase::styleString()
+    // do not always survive round trip of QFont serialization/deserialization,
+    // causing wrong style in the style box to be highlighted when
+    // the chooser dialog is opened. This will cause the style to be changed
+    // when the dialog is closed and the user did not touch the style box.
+    // Hence, construct custom style identifiers sufficient for the purpose.
+    static QString styleIdentifier(const QFont &font);
+
+    void clear();
+
+Q_SIGNALS:
+    void changed();
+
+private:
+    static QList<Style> resolveStyles(const QString &family);
+
+    // Without the translated texts, see styles()
+    QHash<QString, QList<Style>> m_styles;
+    QHash<std::pair<QString, QString>, Sizes> m_sizes;
+};
+
+#endif
@@ -6,12 +6,14 @@
 #ifndef FONTHELPERS_P_H
 #define FONTHELPERS_P_H
 
-// i18n-related helpers for fonts, common to KFont* widgets.
+// i18n-related and other helpers for fonts, common to KFont* widgets.
 
 #include <QCoreApplication>
+#include <QListWidget>
 #include <QString>
 #include <QStringList>
 
+#include <algorithm>
 #include <map>
 
 #ifdef NEVERDEFINE // never true
@@ -123,4 +125,31 @@ inline FontFamiliesMap translateFontNameList(const QStringList &names)
     return trMap;
 }
 
+/*!
+ * @internal
+ *
+ * Update the rows of the list widget to show the given texts, touching only
+ * the rows that differ instead of clearing and refilling the whole list.
+ *
+ * \a list the list widget to update
+ * \a texts the texts of the rows, in order
+ */
+inline void syncListItems(QListWidget *list, const QStringList &texts)
+{
+    const int count = texts.size();
+    const int common = std::min(list->count(), count);
+    for (int row = 0; row < common; ++row) {
+        QListWidgetItem *item = list->item(row);
+        if (item->text() != texts.at(row)) {
+            item->setText(texts.at(row));
+        }
+    }
+    while (list->count() > count) {
+        delete list->takeItem(list->count() - 1);
+    }
+    for (int row = common; row < count; ++row) {
+        list->addItem(texts.at(row));
+    }
+}
+
 #endif
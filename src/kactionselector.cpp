@@ -15,6 +15,8 @@
 #include <QToolButton>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 class KActionSelectorPrivate
 {
 public:
@@ -43,6 +45,17 @@ public:
      */
     void moveItem(QListWidgetItem *item);
 
+    /*!
+      Move the items at @p rows of listbox @p lbFrom to the other listbox,
+      updating the views and emitting the signals once for all of them.
+     */
+    void moveItems(QListWidget *lbFrom, QList<int> rows);
+
+    /*!
+      @return the rows of the selected items of listbox @p lb, in no particular order.
+     */
+    QList<int> selectedRows(QListWidget *lb);
+
     /*!
       loads the icons for the move buttons.
      */
@@ -432,33 +445,13 @@ bool KActionSelector::eventFilter(QObject *o, QEvent *e)
 void KActionSelectorPrivate::buttonAddClicked()
 {
     // move all selected items from available to selected listbox
-    const QList<QListWidgetItem *> list = availableListWidget->selectedItems();
-    for (QListWidgetItem *item : list) {
-        availableListWidget->takeItem(availableListWidget->row(item));
-        selectedListWidget->insertItem(insertionIndex(selectedListWidget, selectedInsertionPolicy), item);
-        selectedListWidget->setCurrentItem(item);
-        Q_EMIT q->added(item);
-    }
-    if (selectedInsertionPolicy == KActionSelector::Sorted) {
-        selectedListWidget->sortItems();
-    }
-    selectedListWidget->setFocus();
+    moveItems(availableListWidget, selectedRows(availableListWidget));
 }
 
 void KActionSelectorPrivate::buttonRemoveClicked()
 {
     // move all selected items from selected to available listbox
-    const QList<QListWidgetItem *> list = selectedListWidget->selectedItems();
-    for (QListWidgetItem *item : list) {
-        selectedListWidget->takeItem(selectedListWidget->row(item));
-        availableListWidget->insertItem(insertionIndex(availableListWidget, availableInsertionPolicy), item);
-        availableListWidget->setCurrentItem(item);
-        Q_EMIT q->removed(item);
-    }
-    if (availableInsertionPolicy == KActionSelector::Sorted) {
-        availableListWidget->sortItems();
-    }
-    availableListWidget->setFocus();
+    moveItems(selectedListWidget, selectedRows(selectedListWidget));
 }
 
 void KActionSelectorPrivate::buttonUpClicked()
@@ -509,30 +502,81 @@ void KActionSelectorPrivate::loadIcons()
 void KActionSelectorPrivate::moveItem(QListWidgetItem *item)
 {
     QListWidget *lbFrom = item->listWidget();
-    QListWidget *lbTo;
-    if (lbFrom == availableListWidget) {
-        lbTo = selectedListWidget;
-    } else if (lbFrom == selectedListWidget) {
-        lbTo = availableListWidget;
-    } else { //?! somewhat unlikely...
+    if (lbFrom != availableListWidget && lbFrom != selectedListWidget) { //?! somewhat unlikely...
         return;
     }
 
+    moveItems(lbFrom, {lbFrom->row(item)});
+}
+
+void KActionSelectorPrivate::moveItems(QListWidget *lbFrom, QList<int> rows)
+{
+    QListWidget *lbTo = (lbFrom == availableListWidget) ? selectedListWidget : availableListWidget;
     KActionSelector::InsertionPolicy p = (lbTo == availableListWidget) ? availableInsertionPolicy : selectedInsertionPolicy;
 
-    lbFrom->takeItem(lbFrom->row(item));
-    lbTo->insertItem(insertionIndex(lbTo, p), item);
-    lbTo->setFocus();
-    lbTo->setCurrentItem(item);
+    if (rows.isEmpty()) {
+        lbTo->setFocus();
+        return;
+    }
+
+    // Repaint both views once, when all items moved
+    lbFrom->setUpdatesEnabled(false);
+    lbTo->setUpdatesEnabled(false);
+
+    // Taking from the bottom keeps the other rows valid, and avoids looking the items up
+    std::sort(rows.begin(), rows.end());
+    QList<QListWidgetItem *> items(rows.size());
+    for (int i = rows.size() - 1; i >= 0; --i) {
+        items[i] = lbFrom->takeItem(rows.at(i));
+    }
 
     if (p == KActionSelector::Sorted) {
+        // QListWidget cannot insert several items at once. Appending does not shift any row,
+        // and sorting once reorders the whole list with a single layout change.
+        for (QListWidgetItem *item : std::as_const(items)) {
+            lbTo->addItem(item);
+        }
         lbTo->sortItems();
+    } else {
+        // Each item used to become the current one when inserted, so for
+        // BelowCurrent the next one goes below it, like for AtBottom
+        int index = std::clamp(insertionIndex(lbTo, p), 0, lbTo->count());
+        for (QListWidgetItem *item : std::as_const(items)) {
+            lbTo->insertItem(index, item);
+            if (p != KActionSelector::AtTop) {
+                ++index;
+            }
+        }
     }
+
+    lbTo->setFocus();
+    lbTo->setCurrentItem(items.last());
+
+    lbFrom->setUpdatesEnabled(true);
+    lbTo->setUpdatesEnabled(true);
+
     if (lbTo == selectedListWidget) {
-        Q_EMIT q->added(item);
+        for (QListWidgetItem *item : std::as_const(items)) {
+            Q_EMIT q->added(item);
+        }
+        Q_EMIT q->addedItems(items);
     } else {
-        Q_EMIT q->removed(item);
+        for (QListWidgetItem *item : std::as_const(items)) {
+            Q_EMIT q->removed(item);
+        }
+        Q_EMIT q->removedItems(items);
+    }
+}
+
+QList<int> KActionSelectorPrivate::selectedRows(QListWidget *lb)
+{
+    const QModelIndexList indexes = lb->selectionModel()->selectedIndexes();
+    QList<int> rows;
+    rows.reserve(indexes.size());
+    for (const QModelIndex &index : indexes) {
+        rows.append(index.row());
     }
+    return rows;
 }
 
 int KActionSelectorPrivate::insertionIndex(QListWidget *lb, KActionSelector::InsertionPolicy policy)
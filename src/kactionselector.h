@@ -305,6 +305,26 @@ Q_SIGNALS:
      */
     void removed(QListWidgetItem *item);
 
+    /*!
+     * Emitted once when \a items are moved to the "selected" listbox together,
+     * after added() was emitted for each of them.
+     *
+     * Prefer this signal when many items can be moved at once.
+     *
+     * \since 6.30
+     */
+    void addedItems(const QList<QListWidgetItem *> &items);
+
+    /*!
+     * Emitted once when \a items are moved out of the "selected" listbox together,
+     * after removed() was emitted for each of them.
+     *
+     * Prefer this signal when many items can be moved at once.
+     *
+     * \since 6.30
+     */
+    void removedItems(const QList<QListWidgetItem *> &items);
+
     /*!
      * Emitted when an item is moved upwards in the "selected" listbox.
      */
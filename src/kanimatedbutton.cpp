@@ -9,12 +9,158 @@
 
 #include <kanimatedbutton.h>
 
+#include <QGlobalStatic>
+#include <QHash>
 #include <QImageReader>
 #include <QMovie>
 #include <QPainter>
 #include <QPixmap>
 #include <QTimer>
 
+#include <limits>
+#include <memory>
+
+// Frames are shown this long if the animation does not say otherwise
+static constexpr int DEFAULT_FRAME_DELAY = 50;
+
+// The frames of an animation, shared by all buttons showing it, e.g. one per window.
+// Frames are cut out of the sheet, or decoded from an animation format, as the
+// buttons first get to them. They are kept at the resolution of the file, the
+// icons scale them to the size and device pixel ratio of each button.
+class KAnimatedButtonFrames
+{
+public:
+    explicit KAnimatedButtonFrames(const QString &path);
+
+    static std::shared_ptr<KAnimatedButtonFrames> forPath(const QString &path);
+
+    int frameCount() const
+    {
+        return m_frameCount;
+    }
+
+    QPixmap frame(int number);
+    int delay(int number) const;
+
+private:
+    void readFrames(int count);
+
+    int m_frameCount = 0;
+    QList<QPixmap> m_frames;
+    QList<int> m_delays;
+
+    // A sheet of square frames, row after row
+    QPixmap m_sheet;
+    int m_iconSize = 0;
+
+    // An animation format, read up to the last frame requested
+    std::unique_ptr<QImageReader> m_reader;
+};
+
+using AnimatedButtonFramesHash = QHash<QString, std::weak_ptr<KAnimatedButtonFrames>>;
+Q_GLOBAL_STATIC(AnimatedButtonFramesHash, s_animatedButtonFrames)
+
+KAnimatedButtonFrames::KAnimatedButtonFrames(const QString &path)
+{
+    auto reader = std::make_unique<QImageReader>(path);
+    if (QMovie::supportedFormats().contains(reader->format())) {
+        m_frameCount = reader->imageCount();
+        m_reader = std::move(reader);
+        if (m_frameCount <= 0) {
+            // The format does not know, count them by reading them all
+            readFrames(std::numeric_limits<int>::max());
+        }
+    } else {
+        const QPixmap pix(path);
+        if (pix.isNull()) {
+            return;
+        }
+
+        const int icon_size = qMin(pix.width(), pix.height());
+        if ((pix.height() % icon_size != 0) || (pix.width() % icon_size != 0)) {
+            return;
+        }
+
+        m_frameCount = (pix.height() / icon_size) * (pix.width() / icon_size);
+        m_sheet = pix;
+        m_iconSize = icon_size;
+    }
+
+    m_frames.resize(m_frameCount);
+}
+
+std::shared_ptr<KAnimatedButtonFrames> KAnimatedButtonFrames::forPath(const QString &path)
+{
+    std::shared_ptr<KAnimatedButtonFrames> frames = s_animatedButtonFrames->value(path).lock();
+    if (!frames) {
+        // The entry goes with the last button, unless the animation was loaded again meanwhile
+        frames.reset(new KAnimatedButtonFrames(path), [path](KAnimatedButtonFrames *frames) {
+            if (!s_animatedButtonFrames.isDestroyed()) {
+                auto it = s_animatedButtonFrames->find(path);
+                if (it != s_animatedButtonFrames->end() && it->expired()) {
+                    s_animatedButtonFrames->erase(it);
+                }
+            }
+            delete frames;
+        });
+        s_animatedButtonFrames->insert(path, frames);
+    }
+    return frames;
+}
+
+void KAnimatedButtonFrames::readFrames(int count)
+{
+    while (m_reader && m_delays.size() < count) {
+        const QImage image = m_reader->read();
+        if (image.isNull()) {
+            // The end, or a broken file: what could be read is the animation
+            m_reader.reset();
+            m_frameCount = m_delays.size();
+            m_frames.resize(m_frameCount);
+            break;
+        }
+        if (m_frames.size() <= m_delays.size()) {
+            m_frames.resize(m_delays.size() + 1);
+        }
+        m_frames[m_delays.size()] = QPixmap::fromImage(image);
+        m_delays.append(m_reader->nextImageDelay());
+    }
+    if (m_reader && m_delays.size() >= m_frameCount) {
+        m_reader.reset();
+    }
+}
+
+QPixmap KAnimatedButtonFrames::frame(int number)
+{
+    if (number < 0 || number >= m_frameCount) {
+        return QPixmap();
+    }
+
+    if (m_reader) {
+        readFrames(number + 1);
+        return m_frames.value(number);
+    }
+
+    QPixmap &frame = m_frames[number];
+    if (frame.isNull() && !m_sheet.isNull()) {
+        const int row_size = m_sheet.width() / m_iconSize;
+        const int row = number / row_size;
+        const int column = number % row_size;
+        frame = QPixmap(m_iconSize, m_iconSize);
+        frame.fill(Qt::transparent);
+        QPainter p(&frame);
+        p.drawPixmap(QPoint(0, 0), m_sheet, QRect(column * m_iconSize, row * m_iconSize, m_iconSize, m_iconSize));
+        p.end();
+    }
+    return frame;
+}
+
+int KAnimatedButtonFrames::delay(int number) const
+{
+    const int delay = m_delays.value(number);
+    return delay > 0 ? delay : DEFAULT_FRAME_DELAY;
+}
+
 class KAnimatedButtonPrivate
 {
 public:
@@ -25,21 +171,17 @@ public:
 
     void updateIcons();
     void updateCurrentIcon();
-    void movieFrameChanged(int number);
-    void movieFinished();
     void timerUpdate();
 
     KAnimatedButton *const q;
-    QMovie *movie = nullptr;
 
-    int frames;
-    int current_frame;
-    QPixmap pixmap;
+    int current_frame = 0;
     QTimer timer;
     QString icon_path;
-    QList<QPixmap *> framesCache; // We keep copies of each frame so that
-    // the icon code can properly cache them in QPixmapCache,
-    // and not fill it up with dead copies
+    // Shared with the other buttons showing the same animation, so that the
+    // frames are read once, and the icon code can properly cache them in
+    // QPixmapCache instead of filling it up with dead copies
+    std::shared_ptr<KAnimatedButtonFrames> animation;
 };
 
 KAnimatedButton::KAnimatedButton(QWidget *parent)
@@ -54,31 +196,23 @@ KAnimatedButton::KAnimatedButton(QWidget *parent)
 KAnimatedButton::~KAnimatedButton()
 {
     d->timer.stop();
-    qDeleteAll(d->framesCache);
-    delete d->movie;
 }
 
 void KAnimatedButton::start()
 {
-    if (d->movie) {
-        d->movie->start();
-    } else {
-        d->current_frame = 0;
-        d->timer.start(50);
+    if (!d->animation) {
+        return;
     }
+
+    d->current_frame = 0;
+    d->timer.start(d->animation->delay(d->current_frame));
 }
 
 void KAnimatedButton::stop()
 {
-    if (d->movie) {
-        d->movie->stop();
-        d->movie->jumpToFrame(0);
-        d->movieFrameChanged(0);
-    } else {
-        d->current_frame = 0;
-        d->timer.stop();
-        d->updateCurrentIcon();
-    }
+    d->current_frame = 0;
+    d->timer.stop();
+    d->updateCurrentIcon();
 }
 
 void KAnimatedButton::setAnimationPath(const QString &path)
@@ -104,93 +238,41 @@ void KAnimatedButtonPrivate::timerUpdate()
     }
 
     current_frame++;
-    if (current_frame == frames) {
+    if (current_frame >= animation->frameCount()) {
+        // loop
         current_frame = 0;
     }
 
     updateCurrentIcon();
+
+    const int delay = animation->delay(current_frame);
+    if (timer.interval() != delay) {
+        timer.setInterval(delay);
+    }
 }
 
 void KAnimatedButtonPrivate::updateCurrentIcon()
 {
-    if (pixmap.isNull()) {
+    if (!animation) {
         return;
     }
 
-    QPixmap *frame = framesCache[current_frame];
-    if (!frame) {
-        const int icon_size = qMin(pixmap.width(), pixmap.height());
-        const int row_size = pixmap.width() / icon_size;
-        const int row = current_frame / row_size;
-        const int column = current_frame % row_size;
-        frame = new QPixmap(icon_size, icon_size);
-        frame->fill(Qt::transparent);
-        QPainter p(frame);
-        p.drawPixmap(QPoint(0, 0), pixmap, QRect(column * icon_size, row * icon_size, icon_size, icon_size));
-        p.end();
-        framesCache[current_frame] = frame;
-    }
-
-    q->setIcon(QIcon(*frame));
-}
-
-void KAnimatedButtonPrivate::movieFrameChanged(int number)
-{
-    Q_UNUSED(number);
-    q->setIcon(QIcon(movie->currentPixmap()));
-}
-
-void KAnimatedButtonPrivate::movieFinished()
-{
-    // if not running, make it loop
-    if (movie->state() == QMovie::NotRunning) {
-        movie->start();
+    const QPixmap frame = animation->frame(current_frame);
+    if (!frame.isNull()) {
+        q->setIcon(QIcon(frame));
     }
 }
 
 void KAnimatedButtonPrivate::updateIcons()
 {
-    pixmap = QPixmap();
-    QMovie *newMovie = nullptr;
-    QImageReader reader(icon_path);
-    if (QMovie::supportedFormats().contains(reader.format())) {
-        newMovie = new QMovie(icon_path);
-        frames = 0;
-        newMovie->setCacheMode(QMovie::CacheAll);
-        QObject::connect(newMovie, &QMovie::frameChanged, q, [this](int value) {
-            movieFrameChanged(value);
-        });
-        QObject::connect(newMovie, &QMovie::finished, q, [this] {
-            movieFinished();
-        });
-    } else {
-        const QPixmap pix(icon_path);
-        if (pix.isNull()) {
-            return;
-        }
-
-        const int icon_size = qMin(pix.width(), pix.height());
-        if ((pix.height() % icon_size != 0) || (pix.width() % icon_size != 0)) {
-            return;
-        }
-
-        frames = (pix.height() / icon_size) * (pix.width() / icon_size);
-        pixmap = pix;
-    }
-
     current_frame = 0;
-    qDeleteAll(framesCache);
-    framesCache.fill(nullptr);
-    framesCache.resize(frames);
-    delete movie;
-    movie = newMovie;
-
-    if (movie) {
-        movie->jumpToFrame(0);
-        movieFrameChanged(0);
-    } else {
-        updateCurrentIcon();
+    animation = KAnimatedButtonFrames::forPath(icon_path);
+    if (animation->frameCount() == 0) {
+        animation.reset();
+        return;
     }
+
+    updateCurrentIcon();
 }
 
 #include "moc_kanimatedbutton.cpp"
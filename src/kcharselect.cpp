@@ -8,6 +8,7 @@
 
 #include "kcharselect.h"
 #include "kcharselect_p.h"
+#include "kwidgetsaddonstiming_p.h"
 
 #include "loggingcategory.h"
 
@@ -223,6 +224,12 @@ void KCharSelectTablePrivate::slotSelectionChanged(const QItemSelection &selecte
     Q_EMIT q->focusItemChanged(c);
 }
 
+void KCharSelectTable::paintEvent(QPaintEvent *e)
+{
+    const KWidgetsAddonsTiming::ScopedTimer timer("KCharSelectTable", KWidgetsAddonsTiming::Paint);
+    QTableView::paintEvent(e);
+}
+
 void KCharSelectTable::resizeEvent(QResizeEvent *e)
 {
     QTableView::resizeEvent(e);
@@ -247,6 +254,7 @@ void KCharSelectTable::resizeEvent(QResizeEvent *e)
 
 void KCharSelectTablePrivate::resizeCells()
 {
+    const KWidgetsAddonsTiming::ScopedTimer timer("KCharSelectTable", KWidgetsAddonsTiming::Layout);
     KCharSelectItemModel *model = static_cast<KCharSelectItemModel *>(q->model());
     if (!model) {
         return;
@@ -1088,6 +1096,7 @@ void KCharSelectPrivate::linkClicked(QUrl url)
 
 QVariant KCharSelectItemModel::data(const QModelIndex &index, int role) const
 {
+    const KWidgetsAddonsTiming::ScopedTimer timer("KCharSelectItemModel", KWidgetsAddonsTiming::ModelQuery);
     int pos = m_columns * (index.row()) + index.column();
     if (!index.isValid() || pos < 0 || pos >= m_chars.size() || index.row() < 0 || index.column() < 0) {
         if (role == Qt::BackgroundRole) {
@@ -71,6 +71,11 @@ protected:
      */
     void keyPressEvent(QKeyEvent *e) override;
 
+    /*!
+     * Reimplemented.
+     */
+    void paintEvent(QPaintEvent *e) override;
+
 Q_SIGNALS:
     /*! Emitted to indicate that character \a c is activated (such as by double-clicking it). */
     void activated(uint c);
@@ -8,9 +8,9 @@
 #include "kcharselectdata_p.h"
 
 #include <QCoreApplication>
-#include <QFile>
 #include <QFutureInterface>
 #include <QRegularExpression>
+#include <QResource>
 #include <QRunnable>
 #include <QStringList>
 #include <QThreadPool>
@@ -85,10 +85,13 @@ bool KCharSelectData::openDataFile()
     if (!dataFile.isEmpty()) {
         return true;
     } else {
-        QFile file(QStringLiteral(":/kf6/kcharselect/kcharselect-data"));
-        file.open(QIODevice::ReadOnly);
-        dataFile = file.readAll();
-        file.close();
+        const QResource resource(QStringLiteral(":/kf6/kcharselect/kcharselect-data"));
+        if (resource.compressionAlgorithm() == QResource::NoCompression) {
+            // Use the data where it is mapped with the library, instead of copying megabytes to the heap
+            dataFile = QByteArray::fromRawData(reinterpret_cast<const char *>(resource.data()), resource.size());
+        } else {
+            dataFile = resource.uncompressedData();
+        }
         if (dataFile.size() < 40) {
             dataFile.clear();
             return false;
@@ -11,6 +11,8 @@
 #include <QLayout>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QPixmap>
+#include <QPointer>
 #include <QStyle>
 #include <QStyleOption>
 #include <QTimeLine>
@@ -19,10 +21,16 @@ class KCollapsibleGroupBoxPrivate
 {
 public:
     KCollapsibleGroupBoxPrivate(KCollapsibleGroupBox *qq);
+    bool changeExpanded(bool expanded);
     void updateChildrenFocus(bool expanded);
     void recalculateHeaderSize();
+    void updateLayoutGeometry();
     QSize contentSize() const;
     QSize contentMinimumSize() const;
+    bool isAnimating() const;
+    void setAnimationValue(qreal value);
+    void beginSnapshot();
+    void endSnapshot();
 
     KCollapsibleGroupBox *const q;
     QTimeLine *animation;
@@ -32,6 +40,11 @@ public:
     QSize headerSize;
     int shortcutId = 0;
     QMap<QWidget *, Qt::FocusPolicy> focusMap; // Used to restore focus policy of widgets.
+    // Set while the box is animated as part of setGroupExpanded()
+    QPointer<QTimeLine> groupAnimation;
+    // While animating, the content is painted from this snapshot and the children are parked out of view
+    QPixmap contentSnapshot;
+    int animationContentHeight = 0;
 };
 
 KCollapsibleGroupBoxPrivate::KCollapsibleGroupBoxPrivate(KCollapsibleGroupBox *qq)
@@ -47,10 +60,13 @@ KCollapsibleGroupBox::KCollapsibleGroupBox(QWidget *parent)
 
     d->animation = new QTimeLine(500, this); // duration matches kmessagewidget
     connect(d->animation, &QTimeLine::valueChanged, this, [this](qreal value) {
-        setFixedHeight((d->contentSize().height() * value) + d->headerSize.height());
+        d->setAnimationValue(value);
     });
     connect(d->animation, &QTimeLine::stateChanged, this, [this](QTimeLine::State state) {
         if (state == QTimeLine::NotRunning) {
+            if (!d->groupAnimation) {
+                d->endSnapshot();
+            }
             d->updateChildrenFocus(d->isExpanded);
         }
     });
@@ -98,22 +114,20 @@ QString KCollapsibleGroupBox::title() const
 
 void KCollapsibleGroupBox::setExpanded(bool expanded)
 {
-    if (expanded == d->isExpanded) {
+    if (!d->changeExpanded(expanded)) {
         return;
     }
 
-    d->isExpanded = expanded;
-    Q_EMIT expandedChanged();
-
-    d->updateChildrenFocus(expanded);
-
     // Only animate when expanding/collapsing while visible.
     if (isVisible()) {
+        // Leave a group animation this box might be part of
+        d->groupAnimation = nullptr;
         d->animation->setDirection(expanded ? QTimeLine::Forward : QTimeLine::Backward);
         // QTimeLine::duration() must be > 0
         const int duration = qMax(1, style()->styleHint(QStyle::SH_Widget_Animation_Duration));
         d->animation->stop();
         d->animation->setDuration(duration);
+        d->beginSnapshot();
         d->animation->start();
 
         // when going from collapsed to expanded changing the child visibility calls an updateGeometry
@@ -135,6 +149,65 @@ bool KCollapsibleGroupBox::isExpanded() const
     return d->isExpanded;
 }
 
+void KCollapsibleGroupBox::setGroupExpanded(const QList<KCollapsibleGroupBox *> &boxes, bool expanded)
+{
+    QList<QPointer<KCollapsibleGroupBox>> animatedBoxes;
+    int duration = 1;
+    for (KCollapsibleGroupBox *box : boxes) {
+        if (!box || box->d->isExpanded == expanded) {
+            continue;
+        }
+        if (!box->isVisible()) {
+            box->setExpanded(expanded);
+            continue;
+        }
+        animatedBoxes.append(box);
+        duration = qMax(duration, box->style()->styleHint(QStyle::SH_Widget_Animation_Duration));
+    }
+    if (animatedBoxes.isEmpty()) {
+        return;
+    }
+
+    // Not owned by any of the boxes, as each of them might go away before the animation ends
+    QTimeLine *timeLine = new QTimeLine(duration);
+    for (KCollapsibleGroupBox *box : std::as_const(animatedBoxes)) {
+        box->d->animation->stop();
+        box->d->changeExpanded(expanded);
+        box->d->groupAnimation = timeLine;
+        box->d->beginSnapshot();
+        // see setExpanded()
+        if (expanded) {
+            box->setFixedHeight(box->d->headerSize.height());
+        }
+        box->update();
+    }
+
+    QObject::connect(timeLine, &QTimeLine::valueChanged, timeLine, [timeLine, animatedBoxes, expanded](qreal value) {
+        bool animating = false;
+        for (KCollapsibleGroupBox *box : animatedBoxes) {
+            if (box && box->d->groupAnimation == timeLine) {
+                box->d->setAnimationValue(expanded ? value : 1 - value);
+                animating = true;
+            }
+        }
+        if (!animating) {
+            timeLine->stop();
+            timeLine->deleteLater();
+        }
+    });
+    QObject::connect(timeLine, &QTimeLine::finished, timeLine, [timeLine, animatedBoxes]() {
+        for (KCollapsibleGroupBox *box : animatedBoxes) {
+            if (box && box->d->groupAnimation == timeLine) {
+                box->d->groupAnimation = nullptr;
+                box->d->endSnapshot();
+                box->d->updateChildrenFocus(box->d->isExpanded);
+            }
+        }
+        timeLine->deleteLater();
+    });
+    timeLine->start();
+}
+
 void KCollapsibleGroupBox::collapse()
 {
     setExpanded(false);
@@ -178,6 +251,10 @@ void KCollapsibleGroupBox::paintEvent(QPaintEvent *event)
     labelOption.rect = style()->subElementRect(QStyle::SE_CheckBoxContents, &labelOption, this);
     style()->drawControl(QStyle::CE_CheckBoxLabel, &labelOption, &p, this);
 
+    if (!d->contentSnapshot.isNull()) {
+        p.drawPixmap(0, 0, d->contentSnapshot);
+    }
+
     Q_UNUSED(event)
 }
 
@@ -227,7 +304,7 @@ bool KCollapsibleGroupBox::event(QEvent *event)
         break;
     }
     case QEvent::LayoutRequest:
-        if (d->animation->state() == QTimeLine::NotRunning) {
+        if (!d->isAnimating()) {
             setFixedHeight(sizeHint().height());
         }
         break;
@@ -283,11 +360,12 @@ void KCollapsibleGroupBox::keyPressEvent(QKeyEvent *event)
 
 void KCollapsibleGroupBox::resizeEvent(QResizeEvent *event)
 {
-    const QMargins margins = contentsMargins();
-
-    if (layout()) {
-        // we don't want the layout trying to fit the current frame of the animation so always set it to the target height
-        layout()->setGeometry(QRect(margins.left(), margins.top(), width() - margins.left() - margins.right(), layout()->sizeHint().height()));
+    if (d->contentSnapshot.isNull()) {
+        d->updateLayoutGeometry();
+    } else if (event->size().width() != event->oldSize().width()) {
+        // The content has to be laid out again for the new width
+        d->endSnapshot();
+        d->beginSnapshot();
     }
 
     QWidget::resizeEvent(event);
@@ -303,6 +381,19 @@ void KCollapsibleGroupBox::overrideFocusPolicyOf(QWidget *widget)
     }
 }
 
+bool KCollapsibleGroupBoxPrivate::changeExpanded(bool expanded)
+{
+    if (expanded == isExpanded) {
+        return false;
+    }
+
+    isExpanded = expanded;
+    Q_EMIT q->expandedChanged();
+
+    updateChildrenFocus(expanded);
+    return true;
+}
+
 void KCollapsibleGroupBoxPrivate::recalculateHeaderSize()
 {
     QStyleOption option;
@@ -314,6 +405,15 @@ void KCollapsibleGroupBoxPrivate::recalculateHeaderSize()
     q->setContentsMargins(q->style()->pixelMetric(QStyle::PM_IndicatorWidth), headerSize.height(), 0, 0);
 }
 
+void KCollapsibleGroupBoxPrivate::updateLayoutGeometry()
+{
+    if (QLayout *layout = q->layout()) {
+        const QMargins margins = q->contentsMargins();
+        // we don't want the layout trying to fit the current frame of the animation so always set it to the target height
+        layout->setGeometry(QRect(margins.left(), margins.top(), q->width() - margins.left() - margins.right(), layout->sizeHint().height()));
+    }
+}
+
 void KCollapsibleGroupBoxPrivate::updateChildrenFocus(bool expanded)
 {
     const auto children = q->children();
@@ -351,4 +451,67 @@ QSize KCollapsibleGroupBoxPrivate::contentMinimumSize() const
     return QSize(0, 0);
 }
 
+bool KCollapsibleGroupBoxPrivate::isAnimating() const
+{
+    return animation->state() == QTimeLine::Running || groupAnimation;
+}
+
+void KCollapsibleGroupBoxPrivate::setAnimationValue(qreal value)
+{
+    q->setFixedHeight((animationContentHeight * value) + headerSize.height());
+}
+
+void KCollapsibleGroupBoxPrivate::beginSnapshot()
+{
+    if (!contentSnapshot.isNull()) {
+        return;
+    }
+
+    animationContentHeight = contentSize().height();
+    QLayout *layout = q->layout();
+    if (!layout) {
+        return;
+    }
+
+    // Render the children once at their final geometry, frames only reveal more or less of it
+    updateLayoutGeometry();
+    const qreal dpr = q->devicePixelRatioF();
+    contentSnapshot = QPixmap(QSize(q->width(), animationContentHeight + headerSize.height()) * dpr);
+    contentSnapshot.setDevicePixelRatio(dpr);
+    contentSnapshot.fill(Qt::transparent);
+
+    const auto children = q->findChildren<QWidget *>(Qt::FindDirectChildrenOnly);
+    QPainter painter(&contentSnapshot);
+    for (QWidget *child : children) {
+        if (!child->isHidden()) {
+            child->render(&painter, child->pos());
+        }
+    }
+    painter.end();
+
+    // Park the children below the box until the animation ends. Unlike hiding them,
+    // this keeps their visibility and focus, and does not post any layout request.
+    layout->setEnabled(false);
+    const QPoint offset(0, animationContentHeight + headerSize.height());
+    for (QWidget *child : children) {
+        child->move(child->pos() + offset);
+    }
+    q->update();
+}
+
+void KCollapsibleGroupBoxPrivate::endSnapshot()
+{
+    if (contentSnapshot.isNull()) {
+        return;
+    }
+
+    contentSnapshot = QPixmap();
+    if (QLayout *layout = q->layout()) {
+        layout->setEnabled(true);
+        layout->invalidate();
+        updateLayoutGeometry();
+    }
+    q->update();
+}
+
 #include "moc_kcollapsiblegroupbox.cpp"
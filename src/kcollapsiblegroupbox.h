@@ -68,6 +68,17 @@ public:
      */
     bool isExpanded() const;
 
+    /*!
+     * Expands or collapses all \a boxes together.
+     *
+     * The animations of the visible boxes are driven by a single timeline,
+     * so a layout holding several of them is updated once per frame
+     * instead of once per box.
+     *
+     * \since 6.30
+     */
+    static void setGroupExpanded(const QList<KCollapsibleGroupBox *> &boxes, bool expanded);
+
     QSize sizeHint() const override;
     QSize minimumSizeHint() const override;
 
@@ -19,6 +19,7 @@
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include <QMimeData>
+#include <QPixmapCache>
 #include <QStylePainter>
 
 class KColorComboDelegate : public QAbstractItemDelegate
@@ -27,6 +28,7 @@ class KColorComboDelegate : public QAbstractItemDelegate
 public:
     enum ItemRoles {
         ColorRole = Qt::UserRole + 1,
+        TextColorRole, // readable text color on top of ColorRole, see contrastTextColor()
     };
 
     enum LayoutMetrics {
@@ -40,6 +42,35 @@ public:
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
 };
 
+static QColor contrastTextColor(const QColor &color)
+{
+    int unused;
+    int v;
+    color.getHsv(&unused, &unused, &v);
+    return v > 128 ? Qt::black : Qt::white;
+}
+
+// Returns the rounded color rectangle shown for an entry and in the combo itself,
+// rendered once per color, size and device pixel ratio into the global pixmap cache.
+static QPixmap colorSwatch(const QColor &color, const QSize &size, qreal dpr)
+{
+    const QString key = QStringLiteral("kcolorcombo_swatch_%1_%2x%3@%4").arg(color.rgba(), 0, 16).arg(size.width()).arg(size.height()).arg(dpr);
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap)) {
+        pixmap = QPixmap(size * dpr);
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::transparent);
+        painter.setBrush(color);
+        painter.drawRoundedRect(QRect(QPoint(0, 0), size), 2, 2);
+        painter.end();
+        QPixmapCache::insert(key, pixmap);
+    }
+    return pixmap;
+}
+
 static QBrush k_colorcombodelegate_brush(const QModelIndex &index, int role)
 {
     QBrush brush;
@@ -85,13 +116,9 @@ void KColorComboDelegate::paint(QPainter *painter, const QStyleOptionViewItem &o
         if (tmpcolor.isValid()) {
             innercolor = tmpcolor;
             paletteBrush = false;
-            painter->setPen(Qt::transparent);
-            painter->setBrush(innercolor);
-            QPainter::RenderHints tmpHint = painter->renderHints();
-            painter->setRenderHint(QPainter::Antialiasing);
-            painter->drawRoundedRect(innerrect, 2, 2);
-            painter->setRenderHints(tmpHint);
-            painter->setBrush(Qt::NoBrush);
+            if (!innerrect.isEmpty()) {
+                painter->drawPixmap(innerrect.topLeft(), colorSwatch(innercolor, innerrect.size(), painter->device()->devicePixelRatioF()));
+            }
         }
     }
     // text
@@ -106,14 +133,9 @@ void KColorComboDelegate::paint(QPainter *painter, const QStyleOptionViewItem &o
                 textColor = option.palette.color(QPalette::Text);
             }
         } else {
-            int unused;
-            int v;
-            innercolor.getHsv(&unused, &unused, &v);
-            if (v > 128) {
-                textColor = Qt::black;
-            } else {
-                textColor = Qt::white;
-            }
+            // precomputed when the color is set
+            const QVariant textColorData = index.data(TextColorRole);
+            textColor = textColorData.userType() == QMetaType::QColor ? textColorData.value<QColor>() : contrastTextColor(innercolor);
         }
         painter->setPen(textColor);
         painter->drawText(innerrect.adjusted(1, 1, -1, -1), text);
@@ -234,6 +256,7 @@ void KColorComboPrivate::setCustomColor(const QColor &color, bool lookupInPreset
     internalcolor = color;
     customColor = color;
     q->setItemData(0, customColor, KColorComboDelegate::ColorRole);
+    q->setItemData(0, contrastTextColor(customColor), KColorComboDelegate::TextColorRole);
     q->update();
 }
 
@@ -316,11 +339,10 @@ void KColorCombo::paintEvent(QPaintEvent *event)
     initStyleOption(&opt);
     painter.drawComplexControl(QStyle::CC_ComboBox, opt);
 
-    QRect frame = style()->subControlRect(QStyle::CC_ComboBox, &opt, QStyle::SC_ComboBoxEditField, this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setPen(Qt::transparent);
-    painter.setBrush(QBrush(d->internalcolor));
-    painter.drawRoundedRect(frame.adjusted(1, 1, -1, -1), 2, 2);
+    const QRect frame = style()->subControlRect(QStyle::CC_ComboBox, &opt, QStyle::SC_ComboBoxEditField, this).adjusted(1, 1, -1, -1);
+    if (!frame.isEmpty()) {
+        painter.drawPixmap(frame.topLeft(), colorSwatch(d->internalcolor, frame.size(), devicePixelRatioF()));
+    }
 }
 
 void KColorCombo::contextMenuEvent(QContextMenuEvent *ev)
@@ -392,11 +414,13 @@ void KColorComboPrivate::addColors()
         for (int i = 0; i < STANDARD_PALETTE_SIZE; ++i) {
             q->addItem(QString());
             q->setItemData(i + 1, standardColor(i), KColorComboDelegate::ColorRole);
+            q->setItemData(i + 1, contrastTextColor(standardColor(i)), KColorComboDelegate::TextColorRole);
         }
     } else {
         for (int i = 0, count = colorList.count(); i < count; ++i) {
             q->addItem(QString());
             q->setItemData(i + 1, colorList[i], KColorComboDelegate::ColorRole);
+            q->setItemData(i + 1, contrastTextColor(colorList[i]), KColorComboDelegate::TextColorRole);
         }
     }
 }
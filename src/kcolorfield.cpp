@@ -0,0 +1,172 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kcolorfield.h"
+
+#include "loggingcategory.h"
+
+#include <QFutureInterface>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <vector>
+
+namespace KColorField
+{
+static bool isHsvChannel(Channel channel)
+{
+    return channel == Hue || channel == Saturation || channel == Value;
+}
+
+// The position of the channel in its color model, h/s/v or r/g/b
+static int channelIndex(Channel channel)
+{
+    return isHsvChannel(channel) ? channel - Hue : channel - Red;
+}
+
+// The highest value of the channel, channels are normalized to [0, 1]
+// except the hue which stops one degree short of a full turn
+static float channelMaximum(Channel channel)
+{
+    return channel == Hue ? 359.0f / 360.0f : 1.0f;
+}
+
+// How much of the HSV chroma is taken away from a RGB component,
+// the branchless form of the conversion which compilers vectorize:
+// component = v - v * s * clamp(min(k, 4 - k), 0, 1), k = (n + 6 * h) mod 6
+static inline float hsvWeight(float k)
+{
+    k = k >= 6.0f ? k - 6.0f : k;
+    return std::clamp(std::min(k, 4.0f - k), 0.0f, 1.0f);
+}
+
+static void hsvToRgb(const float *h, const float *s, const float *v, float *r, float *g, float *b, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const float h6 = h[i] * 6.0f;
+        const float chroma = v[i] * s[i];
+        r[i] = v[i] - chroma * hsvWeight(5.0f + h6);
+        g[i] = v[i] - chroma * hsvWeight(3.0f + h6);
+        b[i] = v[i] - chroma * hsvWeight(1.0f + h6);
+    }
+}
+
+static void packRgb(const float *r, const float *g, const float *b, QRgb *line, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const uint red = uint(r[i] * 255.0f + 0.5f);
+        const uint green = uint(g[i] * 255.0f + 0.5f);
+        const uint blue = uint(b[i] * 255.0f + 0.5f);
+        line[i] = 0xff000000 | (red << 16) | (green << 8) | blue;
+    }
+}
+
+QImage render(const QSize &size, Channel xChannel, Channel yChannel, const QColor &color)
+{
+    if (size.isEmpty()) {
+        return QImage();
+    }
+    if (xChannel == yChannel || isHsvChannel(xChannel) != isHsvChannel(yChannel)) {
+        qCWarning(KWidgetsAddonsLog) << "KColorField::render: invalid channels" << xChannel << yChannel;
+        return QImage();
+    }
+
+    const bool hsv = isHsvChannel(xChannel);
+    float base[3];
+    if (hsv) {
+        const QColor hsvColor = color.toHsv();
+        // Achromatic colors have no hue
+        base[0] = std::max(hsvColor.hsvHueF(), 0.0f);
+        base[1] = hsvColor.hsvSaturationF();
+        base[2] = hsvColor.valueF();
+    } else {
+        base[0] = color.redF();
+        base[1] = color.greenF();
+        base[2] = color.blueF();
+    }
+
+    const int width = size.width();
+    const int height = size.height();
+    const int xIndex = channelIndex(xChannel);
+    const int yIndex = channelIndex(yChannel);
+    const float xStep = width > 1 ? channelMaximum(xChannel) / (width - 1) : 0.0f;
+    const float yStep = height > 1 ? channelMaximum(yChannel) / (height - 1) : 0.0f;
+
+    // One scanline per channel, the x channel is the same for every line
+    std::vector<float> channels[3];
+    for (std::vector<float> &channel : channels) {
+        channel.resize(width);
+    }
+    for (int x = 0; x < width; ++x) {
+        channels[xIndex][x] = x * xStep;
+    }
+    const int baseIndex = 3 - xIndex - yIndex;
+    std::fill(channels[baseIndex].begin(), channels[baseIndex].end(), base[baseIndex]);
+
+    std::vector<float> rgb[3];
+    if (hsv) {
+        for (std::vector<float> &component : rgb) {
+            component.resize(width);
+        }
+    }
+
+    QImage image(size, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        // The y channel grows from bottom to top
+        std::fill(channels[yIndex].begin(), channels[yIndex].end(), (height - 1 - y) * yStep);
+
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        if (hsv) {
+            hsvToRgb(channels[0].data(), channels[1].data(), channels[2].data(), rgb[0].data(), rgb[1].data(), rgb[2].data(), width);
+            packRgb(rgb[0].data(), rgb[1].data(), rgb[2].data(), line, width);
+        } else {
+            packRgb(channels[0].data(), channels[1].data(), channels[2].data(), line, width);
+        }
+    }
+
+    return image;
+}
+
+class RunRender : public QFutureInterface<QImage>, public QRunnable
+{
+public:
+    RunRender(const QSize &size, Channel xChannel, Channel yChannel, const QColor &color)
+        : m_size(size)
+        , m_xChannel(xChannel)
+        , m_yChannel(yChannel)
+        , m_color(color)
+    {
+    }
+
+    QFuture<QImage> start()
+    {
+        setRunnable(this);
+        reportStarted();
+        QFuture<QImage> f = this->future();
+        QThreadPool::globalInstance()->start(this);
+        return f;
+    }
+
+    void run() override
+    {
+        reportResult(render(m_size, m_xChannel, m_yChannel, m_color));
+        reportFinished(nullptr);
+    }
+
+private:
+    const QSize m_size;
+    const Channel m_xChannel;
+    const Channel m_yChannel;
+    const QColor m_color;
+};
+
+QFuture<QImage> renderAsync(const QSize &size, Channel xChannel, Channel yChannel, const QColor &color)
+{
+    return (new RunRender(size, xChannel, yChannel, color))->start();
+}
+}
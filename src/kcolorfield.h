@@ -0,0 +1,88 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KCOLORFIELD_H
+#define KCOLORFIELD_H
+
+#include <kwidgetsaddons_export.h>
+
+#include <QColor>
+#include <QFuture>
+#include <QImage>
+
+/*!
+ * \namespace KColorField
+ * \inmodule KWidgetsAddons
+ *
+ * \brief Renders planes of a color space, as shown by color pickers.
+ *
+ * Meant for the contents of KXYSelector subclasses: the field spans two
+ * channels of a color model, the x channel growing from left to right and
+ * the y channel from bottom to top, while the remaining channel is taken
+ * from a given color.
+ *
+ * The field is computed a scanline at a time, in loops which compilers
+ * vectorize, and can be computed on a worker thread with renderAsync(), so
+ * that large pickers keep up when the third channel changes.
+ *
+ * \code
+ * // in a hue/saturation picker, after the value changed
+ * m_field = KColorField::render(contentsRect().size() * devicePixelRatioF(),
+ *                               KColorField::Hue, KColorField::Saturation, m_color);
+ * m_field.setDevicePixelRatio(devicePixelRatioF());
+ * \endcode
+ *
+ * \since 6.30
+ */
+namespace KColorField
+{
+/*!
+ * The channels a field can span. Both channels of a field belong to the
+ * same color model, either HSV or RGB.
+ *
+ * \value Hue The HSV hue, from 0 to 359 degrees
+ * \value Saturation The HSV saturation
+ * \value Value The HSV value
+ * \value Red The red component
+ * \value Green The green component
+ * \value Blue The blue component
+ */
+enum Channel {
+    Hue,
+    Saturation,
+    Value,
+    Red,
+    Green,
+    Blue,
+};
+
+/*!
+ * Returns an image of \a size pixels, in QImage::Format_RGB32, showing the
+ * plane of \a xChannel and \a yChannel through \a color.
+ *
+ * The channels range over their whole extent, the remaining channel of the
+ * color model is the one of \a color.
+ *
+ * Returns a null image if \a size is empty, or if the channels are the same
+ * or belong to different color models.
+ *
+ * This function is thread-safe.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT QImage render(const QSize &size, Channel xChannel, Channel yChannel, const QColor &color);
+
+/*!
+ * Starts render() on the global thread pool and returns the future image,
+ * to be observed with a QFutureWatcher.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT QFuture<QImage> renderAsync(const QSize &size, Channel xChannel, Channel yChannel, const QColor &color);
+}
+
+#endif // KCOLORFIELD_H
@@ -14,6 +14,8 @@
 #include <QTimer>
 #include <QWidget>
 
+#include <algorithm>
+
 void KCursor::setAutoHideCursor(QWidget *w, bool enable, bool customEventFilter)
 {
     KCursorPrivate::self()->setAutoHideCursor(w, enable, customEventFilter);
@@ -43,11 +45,11 @@ KCursorPrivateAutoHideEventFilter::KCursorPrivateAutoHideEventFilter(QWidget *wi
     , m_isOwnCursor(false)
 {
     mouseWidget()->setMouseTracking(true);
-    connect(&m_autoHideTimer, &QTimer::timeout, this, &KCursorPrivateAutoHideEventFilter::hideCursor);
 }
 
 KCursorPrivateAutoHideEventFilter::~KCursorPrivateAutoHideEventFilter()
 {
+    KCursorPrivate::self()->cancelAutoHide(this);
     if (m_widget != nullptr) {
         mouseWidget()->setMouseTracking(m_wasMouseTracking);
     }
@@ -60,7 +62,7 @@ void KCursorPrivateAutoHideEventFilter::resetWidget()
 
 void KCursorPrivateAutoHideEventFilter::hideCursor()
 {
-    m_autoHideTimer.stop();
+    KCursorPrivate::self()->cancelAutoHide(this);
 
     if (m_isCursorHidden) {
         return;
@@ -80,7 +82,7 @@ void KCursorPrivateAutoHideEventFilter::hideCursor()
 
 void KCursorPrivateAutoHideEventFilter::unhideCursor()
 {
-    m_autoHideTimer.stop();
+    KCursorPrivate::self()->cancelAutoHide(this);
 
     if (!m_isCursorHidden) {
         return;
@@ -143,8 +145,8 @@ bool KCursorPrivateAutoHideEventFilter::eventFilter(QObject *o, QEvent *e)
     case QEvent::Wheel:
         unhideCursor();
         if (m_widget->hasFocus()) {
-            m_autoHideTimer.setSingleShot(true);
-            m_autoHideTimer.start(KCursorPrivate::self()->hideCursorDelay);
+            m_hideDeadline = QDeadlineTimer(KCursorPrivate::self()->hideCursorDelay, Qt::CoarseTimer);
+            KCursorPrivate::self()->scheduleAutoHide(this);
         }
         break;
     default:
@@ -173,6 +175,10 @@ KCursorPrivate::KCursorPrivate()
 {
     hideCursorDelay = 5000; // 5s default value
     enabled = true;
+
+    m_autoHideTimer.setSingleShot(true);
+    m_autoHideTimer.setTimerType(Qt::CoarseTimer);
+    connect(&m_autoHideTimer, &QTimer::timeout, this, &KCursorPrivate::slotAutoHideTimeout);
 }
 
 KCursorPrivate::~KCursorPrivate()
@@ -240,6 +246,51 @@ bool KCursorPrivate::eventFilter(QObject *o, QEvent *e)
     return filter->eventFilter(o, e);
 }
 
+void KCursorPrivate::scheduleAutoHide(KCursorPrivateAutoHideEventFilter *filter)
+{
+    m_pendingAutoHide.insert(filter);
+
+    // Only re-arm if the timer would fire too late, e.g. after the delay was lowered
+    const QDeadlineTimer deadline = filter->hideDeadline();
+    if (deadline < m_autoHideTimeout) {
+        m_autoHideTimeout = deadline;
+        m_autoHideTimer.start(std::max<qint64>(deadline.remainingTime(), 0));
+    }
+}
+
+void KCursorPrivate::cancelAutoHide(KCursorPrivateAutoHideEventFilter *filter)
+{
+    // The timer keeps running, when it fires it finds nothing to do
+    filter->m_hideDeadline = QDeadlineTimer(QDeadlineTimer::Forever);
+    m_pendingAutoHide.remove(filter);
+}
+
+void KCursorPrivate::slotAutoHideTimeout()
+{
+    m_autoHideTimeout = QDeadlineTimer(QDeadlineTimer::Forever);
+
+    QList<KCursorPrivateAutoHideEventFilter *> expired;
+    QDeadlineTimer next(QDeadlineTimer::Forever);
+    for (KCursorPrivateAutoHideEventFilter *filter : std::as_const(m_pendingAutoHide)) {
+        const QDeadlineTimer deadline = filter->hideDeadline();
+        if (deadline.hasExpired()) {
+            expired.append(filter);
+        } else if (deadline < next) {
+            next = deadline;
+        }
+    }
+
+    // Removes the filters from m_pendingAutoHide
+    for (KCursorPrivateAutoHideEventFilter *filter : std::as_const(expired)) {
+        filter->hideCursor();
+    }
+
+    if (!next.isForever()) {
+        m_autoHideTimeout = next;
+        m_autoHideTimer.start(std::max<qint64>(next.remainingTime(), 0));
+    }
+}
+
 void KCursorPrivate::slotViewportDestroyed(QObject *o)
 {
     m_eventFilters.remove(o);
@@ -9,8 +9,10 @@
 #define KCURSOR_P_H
 
 #include <QCursor>
+#include <QDeadlineTimer>
 #include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QTimer>
 
 class QWidget;
@@ -27,6 +29,12 @@ public:
 
     void resetWidget();
 
+    // When the cursor is to be hidden, QDeadlineTimer::Forever unless a hide is pending
+    QDeadlineTimer hideDeadline() const
+    {
+        return m_hideDeadline;
+    }
+
 private Q_SLOTS:
     void hideCursor();
     void unhideCursor();
@@ -34,7 +42,9 @@ private Q_SLOTS:
 private:
     QWidget *mouseWidget() const;
 
-    QTimer m_autoHideTimer;
+    friend class KCursorPrivate;
+
+    QDeadlineTimer m_hideDeadline{QDeadlineTimer::Forever};
     QWidget *m_widget;
     bool m_wasMouseTracking;
     bool m_isCursorHidden;
@@ -53,11 +63,17 @@ public:
     void setAutoHideCursor(QWidget *w, bool enable, bool customEventFilter);
     bool eventFilter(QObject *o, QEvent *e) override;
 
+    // One timer serves all widgets: activity only moves the deadline of its
+    // widget, the timer is re-armed for the next deadline when it fires.
+    void scheduleAutoHide(KCursorPrivateAutoHideEventFilter *filter);
+    void cancelAutoHide(KCursorPrivateAutoHideEventFilter *filter);
+
     int hideCursorDelay;
 
 private Q_SLOTS:
     void slotViewportDestroyed(QObject *);
     void slotWidgetDestroyed(QObject *);
+    void slotAutoHideTimeout();
 
 private:
     KCursorPrivate();
@@ -67,6 +83,11 @@ private:
     static KCursorPrivate *s_self;
 
     QHash<QObject *, KCursorPrivateAutoHideEventFilter *> m_eventFilters;
+
+    QTimer m_autoHideTimer;
+    // When m_autoHideTimer fires, Forever if it is not running
+    QDeadlineTimer m_autoHideTimeout{QDeadlineTimer::Forever};
+    QSet<KCursorPrivateAutoHideEventFilter *> m_pendingAutoHide;
 };
 
 #endif // KCURSOR_PRIVATE_H
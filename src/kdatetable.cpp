@@ -10,6 +10,7 @@
 #include "kdatetable_p.h"
 
 #include "highcontrasthelper_p.h"
+#include "kwidgetsaddonstiming_p.h"
 
 #include <QAction>
 #include <QActionEvent>
@@ -21,7 +22,11 @@
 #include <QStyle>
 #include <QStyleOptionViewItem>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <map>
+#include <optional>
 
 #include "kdaterangecontrol_p.h"
 
@@ -42,6 +47,10 @@ public:
     }
 
     void setDate(const QDate &date);
+    void updateCells();
+    void updateMaxCell();
+    QRectF cellArea(int row, int col) const;
+    void updatePos(int pos);
     void nextMonth();
     void previousMonth();
     void beginningOfMonth();
@@ -94,9 +103,64 @@ public:
         QColor bgColor;
         BackgroundMode bgMode;
     };
-    QHash<int, DatePaintingMode> m_customPaintingModes;
+
+    /*
+     * A run of consecutive days sharing the same painting mode.
+     */
+    struct DatePaintingInterval {
+        qint64 lastJulianDay;
+        DatePaintingMode mode;
+    };
+
+    void setCustomPainting(qint64 firstJulianDay, qint64 lastJulianDay, const DatePaintingMode *mode);
+    const DatePaintingMode *customPainting(const QDate &date) const;
+    void customPaintingChanged();
+
+    /*
+     * Non-overlapping intervals of custom painted days, by their first Julian day.
+     */
+    std::map<qint64, DatePaintingInterval> m_customPaintingIntervals;
+    /*
+     * Custom painting per weekday, indexed by Qt::DayOfWeek - 1.
+     */
+    std::array<std::optional<DatePaintingMode>, 7> m_customWeekdayPaintingModes;
+    int m_customPaintingUpdateDepth = 0;
 
     int m_hoveredPos;
+
+    /*
+     * Everything needed to paint a cell, computed once when the month,
+     * the locale, the palette or the custom date painting change
+     * instead of on every paint.
+     */
+    struct Cell {
+        QString text;
+        QColor textColor;
+        QColor backgroundColor;
+        bool bold = false;
+
+        bool operator==(const Cell &other) const
+        {
+            return text == other.text && textColor == other.textColor && backgroundColor == other.backgroundColor && bold == other.bold;
+        }
+    };
+
+    /*
+     * The cells of the table, row by row, including the header row.
+     */
+    QList<Cell> m_cells;
+    bool m_cellsDirty = true;
+    QDate m_cellsToday;
+    QFont m_cellFont;
+    QFont m_boldCellFont;
+
+    /*
+     * Rendering of all cells without hover decoration.
+     * Cells which changed since it was rendered are listed in m_changedCells.
+     */
+    QPixmap m_gridCache;
+    bool m_gridCacheValid = false;
+    QList<int> m_changedCells;
 };
 
 KDateTable::KDateTable(const QDate &date, QWidget *parent)
@@ -211,188 +275,86 @@ QDate KDateTable::dateFromPos(int position)
 
 void KDateTable::paintEvent(QPaintEvent *e)
 {
+    const KWidgetsAddonsTiming::ScopedTimer timer("KDateTable", KWidgetsAddonsTiming::Paint);
+    d->updateCells();
+
+    const int numCells = d->m_cells.size();
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixelSize = size() * dpr;
+    const QColor baseColor = palette().color(backgroundRole());
+
+    auto paintCachedCell = [this, &baseColor](QPainter *painter, int index, bool clear) {
+        const int row = index / d->m_numDayColumns;
+        const int col = index % d->m_numDayColumns;
+        const QRectF area = d->cellArea(row, col);
+        if (clear) {
+            painter->fillRect(area, baseColor);
+        }
+        painter->save();
+        painter->translate(area.topLeft());
+        paintCell(painter, row, col, false);
+        painter->restore();
+    };
+
+    if (!d->m_gridCacheValid || d->m_gridCache.size() != pixelSize || d->m_gridCache.devicePixelRatio() != dpr) {
+        d->m_gridCache = QPixmap(pixelSize);
+        d->m_gridCache.setDevicePixelRatio(dpr);
+        d->m_gridCache.fill(baseColor);
+        QPainter cachePainter(&d->m_gridCache);
+        for (int index = 0; index < numCells; ++index) {
+            paintCachedCell(&cachePainter, index, false);
+        }
+        d->m_gridCacheValid = true;
+        d->m_changedCells.clear();
+    } else if (!d->m_changedCells.isEmpty()) {
+        QPainter cachePainter(&d->m_gridCache);
+        for (int index : std::as_const(d->m_changedCells)) {
+            paintCachedCell(&cachePainter, index, true);
+        }
+        d->m_changedCells.clear();
+    }
+
     QPainter p(this);
     const QRect &rectToUpdate = e->rect();
-    double cellWidth = width() / (double)d->m_numDayColumns;
-    double cellHeight = height() / (double)d->m_numWeekRows;
-    int leftCol = (int)std::floor(rectToUpdate.left() / cellWidth);
-    int topRow = (int)std::floor(rectToUpdate.top() / cellHeight);
-    int rightCol = (int)std::ceil(rectToUpdate.right() / cellWidth);
-    int bottomRow = (int)std::ceil(rectToUpdate.bottom() / cellHeight);
-    bottomRow = qMin(bottomRow, d->m_numWeekRows - 1);
-    rightCol = qMin(rightCol, d->m_numDayColumns - 1);
-    if (layoutDirection() == Qt::RightToLeft) {
-        p.translate((d->m_numDayColumns - leftCol - 1) * cellWidth, topRow * cellHeight);
-    } else {
-        p.translate(leftCol * cellWidth, topRow * cellHeight);
-    }
-    for (int i = leftCol; i <= rightCol; ++i) {
-        for (int j = topRow; j <= bottomRow; ++j) {
-            paintCell(&p, j, i);
-            p.translate(0, cellHeight);
+    p.drawPixmap(QRectF(rectToUpdate), d->m_gridCache, QRectF(QPointF(rectToUpdate.topLeft()) * dpr, QSizeF(rectToUpdate.size()) * dpr));
+
+    // Only the hovered cell is painted directly
+    const int hoveredIndex = d->m_hoveredPos >= 0 ? d->m_hoveredPos + d->m_numDayColumns : -1;
+    if (hoveredIndex >= 0 && hoveredIndex < numCells) {
+        const int row = hoveredIndex / d->m_numDayColumns;
+        const int col = hoveredIndex % d->m_numDayColumns;
+        const QRectF area = d->cellArea(row, col);
+        if (area.intersects(rectToUpdate)) {
+            p.fillRect(area, baseColor);
+            p.translate(area.topLeft());
+            paintCell(&p, row, col, true);
         }
-        if (layoutDirection() == Qt::RightToLeft) {
-            p.translate(-cellWidth, 0);
-        } else {
-            p.translate(cellWidth, 0);
-        }
-        p.translate(0, -cellHeight * (bottomRow - topRow + 1));
     }
 }
 
-void KDateTable::paintCell(QPainter *painter, int row, int col)
+void KDateTable::paintCell(QPainter *painter, int row, int col, bool hovered)
 {
     double w = (width() / (double)d->m_numDayColumns) - 1;
     double h = (height() / (double)d->m_numWeekRows) - 1;
     QRectF cell = QRectF(0, 0, w, h);
-    QString cellText;
-    QColor cellBackgroundColor;
-    QColor cellTextColor;
-    QFont cellFont = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
-    bool workingDay = false;
-    int cellWeekDay;
-    int pos;
-
-    // Calculate the position of the cell in the grid
-    pos = d->m_numDayColumns * (row - 1) + col;
-
-    // Calculate what day of the week the cell is
-    if (col + locale().firstDayOfWeek() <= d->m_numDayColumns) {
-        cellWeekDay = col + locale().firstDayOfWeek();
-    } else {
-        cellWeekDay = col + locale().firstDayOfWeek() - d->m_numDayColumns;
-    }
-
-    // FIXME This is wrong if the widget is not using the global!
-    // See if cell day is normally a working day
-    if (locale().weekdays().first() <= locale().weekdays().last()) {
-        if (cellWeekDay >= locale().weekdays().first() && cellWeekDay <= locale().weekdays().last()) {
-            workingDay = true;
-        }
-    } else {
-        if (cellWeekDay >= locale().weekdays().first() //
-            || cellWeekDay <= locale().weekdays().last()) {
-            workingDay = true;
-        }
-    }
-
-    if (row == 0) {
-        // We are drawing a header cell
-
-        // If not a normal working day, then use "do not work today" color
-        if (!workingDay && !isHighContrastColorSchemeInUse()) {
-            cellTextColor = Qt::darkRed;
-        } else {
-            cellTextColor = palette().color(QPalette::WindowText);
-        }
-        cellBackgroundColor = palette().color(QPalette::Window);
-
-        // Set the text to the short day name and bold it
-        cellFont.setBold(true);
-        cellText = locale().dayName(cellWeekDay, QLocale::ShortFormat);
-
-    } else {
-        // We are drawing a day cell
-
-        // Calculate the date the cell represents
-        QDate cellDate = dateFromPos(pos);
-
-        bool validDay = cellDate.isValid();
-
-        // Draw the day number in the cell, if the date is not valid then we don't want to show it
-        if (validDay) {
-            cellText = locale().toString(cellDate.day());
-        } else {
-            cellText = QString();
-        }
-
-        if (!validDay || cellDate.month() != d->m_date.month()) {
-            // we are either
-            // ° painting an invalid day
-            // ° painting a day of the previous month or
-            // ° painting a day of the following month or
-            cellBackgroundColor = palette().color(backgroundRole());
-            cellTextColor = palette().color(QPalette::Disabled, QPalette::Text);
-        } else {
-            // Paint a day of the current month
-
-            // Background Colour priorities will be (high-to-low):
-            // * Selected Day Background Colour
-            // * Customized Day Background Colour
-            // * Normal Day Background Colour
-
-            // Background Shape priorities will be (high-to-low):
-            // * Customized Day Shape
-            // * Normal Day Shape
-
-            // Text Colour priorities will be (high-to-low):
-            // * Customized Day Colour
-            // * Day of Pray Colour (Red letter)
-            // * Selected Day Colour
-            // * Normal Day Colour
-
-            // Determine various characteristics of the cell date
-            bool selectedDay = (cellDate == date());
-            bool currentDay = (cellDate == QDate::currentDate());
-            bool dayOfPray = (cellDate.dayOfWeek() == Qt::Sunday);
-            // TODO: Uncomment if QLocale ever gets the feature...
-            // bool dayOfPray = ( cellDate.dayOfWeek() == locale().dayOfPray() );
-            bool customDay = (d->m_useCustomColors && d->m_customPaintingModes.contains(cellDate.toJulianDay()));
-
-            // Default values for a normal cell
-            cellBackgroundColor = palette().color(backgroundRole());
-            cellTextColor = palette().color(foregroundRole());
-
-            // If we are drawing the current date, then draw it bold and active
-            if (currentDay) {
-                cellFont.setBold(true);
-                cellTextColor = palette().color(QPalette::LinkVisited);
-            }
-
-            // if we are drawing the day cell currently selected in the table
-            if (selectedDay) {
-                // set the background to highlighted
-                cellBackgroundColor = palette().color(QPalette::Highlight);
-                cellTextColor = palette().color(QPalette::HighlightedText);
-            }
-
-            // If custom colors or shape are required for this date
-            if (customDay) {
-                KDateTablePrivate::DatePaintingMode mode = d->m_customPaintingModes[cellDate.toJulianDay()];
-                if (mode.bgMode != NoBgMode) {
-                    if (!selectedDay) {
-                        cellBackgroundColor = mode.bgColor;
-                    }
-                }
-                cellTextColor = mode.fgColor;
-            }
-
-            // If the cell day is the day of religious observance, then always color text red unless Custom overrides
-            if (!customDay && dayOfPray && !isHighContrastColorSchemeInUse()) {
-                cellTextColor = Qt::darkRed;
-            }
-        }
-
-        // If the cell day is out of the allowed range, paint it as disabled
-        if (!d->isInDateRange(cellDate)) {
-            cellBackgroundColor = palette().color(QPalette::Disabled, backgroundRole());
-        }
-    }
+    const KDateTablePrivate::Cell &cellData = d->m_cells.at(row * d->m_numDayColumns + col);
+    const QColor &cellBackgroundColor = cellData.backgroundColor;
+    const QColor baseColor = palette().color(backgroundRole());
 
     // Draw the background
     if (row == 0) {
         painter->setPen(cellBackgroundColor);
         painter->setBrush(cellBackgroundColor);
         painter->drawRect(cell);
-    } else if (cellBackgroundColor != palette().color(backgroundRole()) || pos == d->m_hoveredPos) {
+    } else if (cellBackgroundColor != baseColor || hovered) {
         QStyleOptionViewItem opt;
         opt.initFrom(this);
         opt.rect = cell.toRect();
-        if (cellBackgroundColor != palette().color(backgroundRole())) {
+        if (cellBackgroundColor != baseColor) {
             opt.palette.setBrush(QPalette::Highlight, cellBackgroundColor);
             opt.state |= QStyle::State_Selected;
         }
-        if (pos == d->m_hoveredPos && opt.state & QStyle::State_Enabled) {
+        if (hovered && opt.state & QStyle::State_Enabled) {
             opt.state |= QStyle::State_MouseOver;
         } else {
             opt.state &= ~QStyle::State_MouseOver;
@@ -403,9 +365,9 @@ void KDateTable::paintCell(QPainter *painter, int row, int col)
     }
 
     // Draw the text
-    painter->setPen(cellTextColor);
-    painter->setFont(cellFont);
-    painter->drawText(cell, Qt::AlignCenter, cellText, &cell);
+    painter->setPen(cellData.textColor);
+    painter->setFont(cellData.bold ? d->m_boldCellFont : d->m_cellFont);
+    painter->drawText(cell, Qt::AlignCenter, cellData.text, &cell);
 
     // Draw the base line
     if (row == 0) {
@@ -423,6 +385,186 @@ void KDateTable::paintCell(QPainter *painter, int row, int col)
     }
 }
 
+void KDateTable::KDateTablePrivate::updateCells()
+{
+    const QDate today = QDate::currentDate();
+    if (!m_cellsDirty && today == m_cellsToday) {
+        return;
+    }
+    m_cellsDirty = false;
+    m_cellsToday = today;
+
+    const QLocale locale = q->locale();
+    const QPalette palette = q->palette();
+    const int firstDayOfWeek = locale.firstDayOfWeek();
+    const QList<Qt::DayOfWeek> weekdays = locale.weekdays();
+    const bool highContrast = isHighContrastColorSchemeInUse();
+    const QColor baseColor = palette.color(q->backgroundRole());
+
+    m_cellFont = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
+    m_boldCellFont = m_cellFont;
+    m_boldCellFont.setBold(true);
+
+    QList<Cell> cells(m_numWeekRows * m_numDayColumns);
+    for (int col = 0; col < m_numDayColumns; ++col) {
+        // Calculate what day of the week the cell is
+        int cellWeekDay;
+        if (col + firstDayOfWeek <= m_numDayColumns) {
+            cellWeekDay = col + firstDayOfWeek;
+        } else {
+            cellWeekDay = col + firstDayOfWeek - m_numDayColumns;
+        }
+
+        // FIXME This is wrong if the widget is not using the global!
+        // See if cell day is normally a working day
+        bool workingDay = false;
+        if (weekdays.first() <= weekdays.last()) {
+            if (cellWeekDay >= weekdays.first() && cellWeekDay <= weekdays.last()) {
+                workingDay = true;
+            }
+        } else {
+            if (cellWeekDay >= weekdays.first() //
+                || cellWeekDay <= weekdays.last()) {
+                workingDay = true;
+            }
+        }
+
+        // The header cell
+
+        Cell &header = cells[col];
+        // If not a normal working day, then use "do not work today" color
+        if (!workingDay && !highContrast) {
+            header.textColor = Qt::darkRed;
+        } else {
+            header.textColor = palette.color(QPalette::WindowText);
+        }
+        header.backgroundColor = palette.color(QPalette::Window);
+
+        // Set the text to the short day name and bold it
+        header.bold = true;
+        header.text = locale.dayName(cellWeekDay, QLocale::ShortFormat);
+
+        // The day cells
+        for (int row = 1; row < m_numWeekRows; ++row) {
+            Cell &cell = cells[row * m_numDayColumns + col];
+
+            // Calculate the date the cell represents
+            const int pos = m_numDayColumns * (row - 1) + col;
+            const QDate cellDate = q->dateFromPos(pos);
+
+            bool validDay = cellDate.isValid();
+
+            // Draw the day number in the cell, if the date is not valid then we don't want to show it
+            if (validDay) {
+                cell.text = locale.toString(cellDate.day());
+            }
+
+            if (!validDay || cellDate.month() != m_date.month()) {
+                // we are either
+                // ° painting an invalid day
+                // ° painting a day of the previous month or
+                // ° painting a day of the following month or
+                cell.backgroundColor = baseColor;
+                cell.textColor = palette.color(QPalette::Disabled, QPalette::Text);
+            } else {
+                // Paint a day of the current month
+
+                // Background Colour priorities will be (high-to-low):
+                // * Selected Day Background Colour
+                // * Customized Day Background Colour
+                // * Normal Day Background Colour
+
+                // Background Shape priorities will be (high-to-low):
+                // * Customized Day Shape
+                // * Normal Day Shape
+
+                // Text Colour priorities will be (high-to-low):
+                // * Customized Day Colour
+                // * Day of Pray Colour (Red letter)
+                // * Selected Day Colour
+                // * Normal Day Colour
+
+                // Determine various characteristics of the cell date
+                bool selectedDay = (cellDate == m_date);
+                bool currentDay = (cellDate == today);
+                bool dayOfPray = (cellDate.dayOfWeek() == Qt::Sunday);
+                // TODO: Uncomment if QLocale ever gets the feature...
+                // bool dayOfPray = ( cellDate.dayOfWeek() == locale().dayOfPray() );
+                const DatePaintingMode *customMode = m_useCustomColors ? customPainting(cellDate) : nullptr;
+                bool customDay = (customMode != nullptr);
+
+                // Default values for a normal cell
+                cell.backgroundColor = baseColor;
+                cell.textColor = palette.color(q->foregroundRole());
+
+                // If we are drawing the current date, then draw it bold and active
+                if (currentDay) {
+                    cell.bold = true;
+                    cell.textColor = palette.color(QPalette::LinkVisited);
+                }
+
+                // if we are drawing the day cell currently selected in the table
+                if (selectedDay) {
+                    // set the background to highlighted
+                    cell.backgroundColor = palette.color(QPalette::Highlight);
+                    cell.textColor = palette.color(QPalette::HighlightedText);
+                }
+
+                // If custom colors or shape are required for this date
+                if (customDay) {
+                    const DatePaintingMode &mode = *customMode;
+                    if (mode.bgMode != NoBgMode) {
+                        if (!selectedDay) {
+                            cell.backgroundColor = mode.bgColor;
+                        }
+                    }
+                    cell.textColor = mode.fgColor;
+                }
+
+                // If the cell day is the day of religious observance, then always color text red unless Custom overrides
+                if (!customDay && dayOfPray && !highContrast) {
+                    cell.textColor = Qt::darkRed;
+                }
+            }
+
+            // If the cell day is out of the allowed range, paint it as disabled
+            if (!isInDateRange(cellDate)) {
+                cell.backgroundColor = palette.color(QPalette::Disabled, q->backgroundRole());
+            }
+        }
+    }
+
+    // Only re-render the cells which actually changed, e.g. the old and the
+    // new selected day when moving the selection within the month
+    if (m_gridCacheValid && cells.size() == m_cells.size()) {
+        for (int index = 0; index < cells.size(); ++index) {
+            if (!(cells.at(index) == m_cells.at(index)) && !m_changedCells.contains(index)) {
+                m_changedCells.append(index);
+            }
+        }
+    } else {
+        m_gridCacheValid = false;
+    }
+    m_cells = cells;
+}
+
+QRectF KDateTable::KDateTablePrivate::cellArea(int row, int col) const
+{
+    const double cellWidth = q->width() / (double)m_numDayColumns;
+    const double cellHeight = q->height() / (double)m_numWeekRows;
+    const int visualCol = q->layoutDirection() == Qt::RightToLeft ? m_numDayColumns - col - 1 : col;
+    return QRectF(visualCol * cellWidth, row * cellHeight, cellWidth, cellHeight);
+}
+
+void KDateTable::KDateTablePrivate::updatePos(int pos)
+{
+    if (pos < 0) {
+        return;
+    }
+    const int index = pos + m_numDayColumns;
+    q->update(cellArea(index / m_numDayColumns, index % m_numDayColumns).toAlignedRect());
+}
+
 void KDateTable::KDateTablePrivate::nextMonth()
 {
     // setDate does validity checking for us
@@ -511,22 +653,27 @@ void KDateTable::keyPressEvent(QKeyEvent *e)
 
 void KDateTable::setFontSize(int size)
 {
-    QFontMetricsF metrics(fontMetrics());
-    QRectF rect;
-    // ----- store rectangles:
     d->fontsize = size;
+    d->updateMaxCell();
+}
+
+void KDateTable::KDateTablePrivate::updateMaxCell()
+{
+    QFontMetricsF metrics(q->fontMetrics());
+    QRectF rect;
     // ----- find largest day name:
-    d->m_maxCell.setWidth(0);
-    d->m_maxCell.setHeight(0);
+    m_maxCell.setWidth(0);
+    m_maxCell.setHeight(0);
+    const QLocale locale = q->locale();
     for (int weekday = 1; weekday <= 7; ++weekday) {
-        rect = metrics.boundingRect(locale().dayName(weekday, QLocale::ShortFormat));
-        d->m_maxCell.setWidth(qMax(d->m_maxCell.width(), rect.width()));
-        d->m_maxCell.setHeight(qMax(d->m_maxCell.height(), rect.height()));
+        rect = metrics.boundingRect(locale.dayName(weekday, QLocale::ShortFormat));
+        m_maxCell.setWidth(qMax(m_maxCell.width(), rect.width()));
+        m_maxCell.setHeight(qMax(m_maxCell.height(), rect.height()));
     }
     // ----- compare with a real wide number and add some space:
     rect = metrics.boundingRect(QStringLiteral("88"));
-    d->m_maxCell.setWidth(qMax(d->m_maxCell.width() + 2, rect.width()));
-    d->m_maxCell.setHeight(qMax(d->m_maxCell.height() + 4, rect.height()));
+    m_maxCell.setWidth(qMax(m_maxCell.width() + 2, rect.width()));
+    m_maxCell.setHeight(qMax(m_maxCell.height() + 4, rect.height()));
 }
 
 void KDateTable::wheelEvent(QWheelEvent *e)
@@ -551,17 +698,31 @@ bool KDateTable::event(QEvent *ev)
         const int pos = row < 1 ? -1 : (d->m_numDayColumns * (row - 1)) + col;
 
         if (pos != d->m_hoveredPos) {
+            d->updatePos(d->m_hoveredPos);
             d->m_hoveredPos = pos;
-            update();
+            d->updatePos(d->m_hoveredPos);
         }
         break;
     }
     case QEvent::HoverLeave:
         if (d->m_hoveredPos != -1) {
+            d->updatePos(d->m_hoveredPos);
             d->m_hoveredPos = -1;
-            update();
         }
         break;
+    case QEvent::LocaleChange:
+    case QEvent::FontChange:
+        d->updateMaxCell();
+        d->m_cellsDirty = true;
+        d->m_gridCacheValid = false;
+        break;
+    case QEvent::PaletteChange:
+    case QEvent::StyleChange:
+    case QEvent::EnabledChange:
+    case QEvent::LayoutDirectionChange:
+        d->m_cellsDirty = true;
+        d->m_gridCacheValid = false;
+        break;
     default:
         break;
     }
@@ -633,6 +794,7 @@ void KDateTable::KDateTablePrivate::setDate(const QDate &date)
     m_weekDayFirstOfMonth = QDate(date.year(), date.month(), 1).dayOfWeek();
     m_numDaysThisMonth = m_date.daysInMonth();
     m_numDayColumns = 7;
+    m_cellsDirty = true;
 }
 
 bool KDateTable::setDate(const QDate &toDate)
@@ -692,9 +854,23 @@ bool KDateTable::popupMenuEnabled() const
 }
 
 void KDateTable::setCustomDatePainting(const QDate &date, const QColor &fgColor, BackgroundMode bgMode, const QColor &bgColor)
+{
+    setCustomDatePainting(date, date, fgColor, bgMode, bgColor);
+}
+
+void KDateTable::unsetCustomDatePainting(const QDate &date)
+{
+    unsetCustomDatePainting(date, date);
+}
+
+void KDateTable::setCustomDatePainting(const QDate &from, const QDate &to, const QColor &fgColor, BackgroundMode bgMode, const QColor &bgColor)
 {
     if (!fgColor.isValid()) {
-        unsetCustomDatePainting(date);
+        unsetCustomDatePainting(from, to);
+        return;
+    }
+
+    if (!from.isValid() || !to.isValid() || from > to) {
         return;
     }
 
@@ -703,23 +879,138 @@ void KDateTable::setCustomDatePainting(const QDate &date, const QColor &fgColor,
     mode.fgColor = fgColor;
     mode.bgColor = bgColor;
 
-    d->m_customPaintingModes.insert(date.toJulianDay(), mode);
-    d->m_useCustomColors = true;
-    update();
+    d->setCustomPainting(from.toJulianDay(), to.toJulianDay(), &mode);
+    d->customPaintingChanged();
 }
 
-void KDateTable::unsetCustomDatePainting(const QDate &date)
+void KDateTable::unsetCustomDatePainting(const QDate &from, const QDate &to)
 {
-    d->m_customPaintingModes.remove(date.toJulianDay());
-    if (d->m_customPaintingModes.isEmpty()) {
-        d->m_useCustomColors = false;
+    if (!from.isValid() || !to.isValid() || from > to) {
+        return;
+    }
+
+    d->setCustomPainting(from.toJulianDay(), to.toJulianDay(), nullptr);
+    d->customPaintingChanged();
+}
+
+void KDateTable::setCustomWeekdayPainting(Qt::DayOfWeek weekday, const QColor &fgColor, BackgroundMode bgMode, const QColor &bgColor)
+{
+    if (!fgColor.isValid()) {
+        unsetCustomWeekdayPainting(weekday);
+        return;
+    }
+
+    if (weekday < Qt::Monday || weekday > Qt::Sunday) {
+        return;
+    }
+
+    KDateTablePrivate::DatePaintingMode mode;
+    mode.bgMode = bgMode;
+    mode.fgColor = fgColor;
+    mode.bgColor = bgColor;
+
+    d->m_customWeekdayPaintingModes[weekday - 1] = mode;
+    d->customPaintingChanged();
+}
+
+void KDateTable::unsetCustomWeekdayPainting(Qt::DayOfWeek weekday)
+{
+    if (weekday < Qt::Monday || weekday > Qt::Sunday) {
+        return;
+    }
+
+    d->m_customWeekdayPaintingModes[weekday - 1].reset();
+    d->customPaintingChanged();
+}
+
+void KDateTable::clearCustomDatePainting()
+{
+    d->m_customPaintingIntervals.clear();
+    d->m_customWeekdayPaintingModes.fill(std::nullopt);
+    d->customPaintingChanged();
+}
+
+void KDateTable::beginCustomDatePaintingUpdate()
+{
+    ++d->m_customPaintingUpdateDepth;
+}
+
+void KDateTable::endCustomDatePaintingUpdate()
+{
+    if (d->m_customPaintingUpdateDepth == 0) {
+        return;
+    }
+    --d->m_customPaintingUpdateDepth;
+    d->customPaintingChanged();
+}
+
+void KDateTable::KDateTablePrivate::setCustomPainting(qint64 firstJulianDay, qint64 lastJulianDay, const DatePaintingMode *mode)
+{
+    auto &intervals = m_customPaintingIntervals;
+
+    // Cut the interval starting before and reaching into the new one
+    auto it = intervals.upper_bound(firstJulianDay);
+    if (it != intervals.begin()) {
+        --it;
+        if (it->first < firstJulianDay && it->second.lastJulianDay >= firstJulianDay) {
+            const DatePaintingInterval overlapped = it->second;
+            it->second.lastJulianDay = firstJulianDay - 1;
+            if (overlapped.lastJulianDay > lastJulianDay) {
+                intervals.insert_or_assign(lastJulianDay + 1, DatePaintingInterval{overlapped.lastJulianDay, overlapped.mode});
+            }
+        }
+    }
+
+    // Remove the intervals starting inside the new one, keeping what reaches past its end
+    it = intervals.lower_bound(firstJulianDay);
+    while (it != intervals.end() && it->first <= lastJulianDay) {
+        if (it->second.lastJulianDay > lastJulianDay) {
+            const DatePaintingInterval rest = it->second;
+            intervals.erase(it);
+            intervals.insert_or_assign(lastJulianDay + 1, rest);
+            break;
+        }
+        it = intervals.erase(it);
+    }
+
+    if (mode) {
+        intervals.insert_or_assign(firstJulianDay, DatePaintingInterval{lastJulianDay, *mode});
+    }
+}
+
+const KDateTable::KDateTablePrivate::DatePaintingMode *KDateTable::KDateTablePrivate::customPainting(const QDate &date) const
+{
+    const qint64 julianDay = date.toJulianDay();
+    auto it = m_customPaintingIntervals.upper_bound(julianDay);
+    if (it != m_customPaintingIntervals.begin()) {
+        --it;
+        if (it->second.lastJulianDay >= julianDay) {
+            return &it->second.mode;
+        }
+    }
+
+    const auto &weekdayMode = m_customWeekdayPaintingModes[date.dayOfWeek() - 1];
+    return weekdayMode ? &*weekdayMode : nullptr;
+}
+
+void KDateTable::KDateTablePrivate::customPaintingChanged()
+{
+    const auto hasMode = [](const std::optional<DatePaintingMode> &mode) {
+        return mode.has_value();
+    };
+    m_useCustomColors =
+        !m_customPaintingIntervals.empty() || std::any_of(m_customWeekdayPaintingModes.cbegin(), m_customWeekdayPaintingModes.cend(), hasMode);
+    m_cellsDirty = true;
+    if (m_customPaintingUpdateDepth == 0) {
+        q->update();
     }
-    update();
 }
 
 void KDateTable::setDateRange(const QDate &minDate, const QDate &maxDate)
 {
     d->setDateRange(minDate, maxDate);
+    d->m_cellsDirty = true;
+    update();
 }
 
 #include "moc_kdatetable_p.cpp"
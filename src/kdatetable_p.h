@@ -103,6 +103,55 @@ public:
      */
     void unsetCustomDatePainting(const QDate &date);
 
+    /*!
+     * Makes all dates from \a from to \a to (both inclusive) be painted with
+     * a given foregroundColor, and background in a given color.
+     *
+     * Custom painting set for single dates or ranges takes precedence over
+     * the one set for weekdays.
+     */
+    void setCustomDatePainting(const QDate &from,
+                               const QDate &to,
+                               const QColor &fgColor,
+                               BackgroundMode bgMode = NoBgMode,
+                               const QColor &bgColor = QColor());
+
+    /*!
+     * Unsets the custom painting of all dates from \a from to \a to (both inclusive).
+     */
+    void unsetCustomDatePainting(const QDate &from, const QDate &to);
+
+    /*!
+     * Makes every date falling on \a weekday be painted with a given
+     * foregroundColor, and background in a given color.
+     */
+    void setCustomWeekdayPainting(Qt::DayOfWeek weekday, const QColor &fgColor, BackgroundMode bgMode = NoBgMode, const QColor &bgColor = QColor());
+
+    /*!
+     * Unsets the custom painting of \a weekday.
+     */
+    void unsetCustomWeekdayPainting(Qt::DayOfWeek weekday);
+
+    /*!
+     * Unsets all custom painting of dates and weekdays.
+     */
+    void clearCustomDatePainting();
+
+    /*!
+     * Starts a batch of custom painting changes.
+     *
+     * Until the matching endCustomDatePaintingUpdate() the table is not
+     * updated, so setting the painting of many dates results in a single
+     * repaint. Calls can be nested.
+     */
+    void beginCustomDatePaintingUpdate();
+
+    /*!
+     * Ends a batch of custom painting changes started with
+     * beginCustomDatePaintingUpdate() and repaints the table once.
+     */
+    void endCustomDatePaintingUpdate();
+
     /**
      * Sets the valid date range. Dates outside this range will be styled differently and cannot be selected.
      */
@@ -162,7 +211,7 @@ private:
 
     void initWidget(const QDate &date);
     void initAccels();
-    void paintCell(QPainter *painter, int row, int col);
+    void paintCell(QPainter *painter, int row, int col, bool hovered);
 
     Q_DISABLE_COPY(KDateTable)
 };
@@ -13,6 +13,7 @@
 #include <QApplication>
 #include <QComboBox>
 #include <QHBoxLayout>
+#include <QHash>
 #include <QKeyEvent>
 #include <QLineEdit>
 #include <QListView>
@@ -47,6 +48,19 @@ public:
     void updateButtonState();
     QModelIndex selectedIndex();
 
+    // Occurrences of the entries of the model, so that duplicate checks are
+    // a hash lookup. Changes made here keep it up to date, any other change
+    // of the model drops it, to be rebuilt once on the next check.
+    QHash<QString, int> entryCounts;
+    bool entryCountsValid = false;
+    // Set while changing the model and entryCounts together
+    bool updatingModel = false;
+
+    bool containsEntry(const QString &text);
+    void countEntry(const QString &text, int delta);
+    void setEntry(const QModelIndex &index, const QString &text);
+    void insertEntry(int row, const QString &text);
+
 private:
     KEditListWidget *const q;
 };
@@ -69,6 +83,16 @@ void KEditListWidgetPrivate::init(bool check, KEditListWidget::Buttons newButton
     listView = new QListView(q);
     listView->setModel(model);
 
+    const auto modelChanged = [this]() {
+        if (!updatingModel) {
+            entryCountsValid = false;
+        }
+    };
+    q->connect(model, &QAbstractItemModel::dataChanged, q, modelChanged);
+    q->connect(model, &QAbstractItemModel::rowsInserted, q, modelChanged);
+    q->connect(model, &QAbstractItemModel::rowsRemoved, q, modelChanged);
+    q->connect(model, &QAbstractItemModel::modelReset, q, modelChanged);
+
     subLayout->addWidget(listView);
     subLayout->addLayout(btnsLayout);
 
@@ -82,6 +106,54 @@ void KEditListWidgetPrivate::init(bool check, KEditListWidget::Buttons newButton
     q->connect(listView->selectionModel(), &QItemSelectionModel::selectionChanged, q, &KEditListWidget::slotSelectionChanged);
 }
 
+bool KEditListWidgetPrivate::containsEntry(const QString &text)
+{
+    if (!entryCountsValid) {
+        entryCounts.clear();
+        const QStringList entries = model->stringList();
+        entryCounts.reserve(entries.size());
+        for (const QString &entry : entries) {
+            ++entryCounts[entry];
+        }
+        entryCountsValid = true;
+    }
+    return entryCounts.contains(text);
+}
+
+void KEditListWidgetPrivate::countEntry(const QString &text, int delta)
+{
+    if (!entryCountsValid) {
+        return;
+    }
+    auto it = entryCounts.find(text);
+    if (it == entryCounts.end()) {
+        entryCounts.insert(text, delta);
+    } else if ((*it += delta) <= 0) {
+        entryCounts.erase(it);
+    }
+}
+
+void KEditListWidgetPrivate::setEntry(const QModelIndex &index, const QString &text)
+{
+    countEntry(model->data(index, Qt::DisplayRole).toString(), -1);
+    countEntry(text, 1);
+    updatingModel = true;
+    model->setData(index, text);
+    updatingModel = false;
+}
+
+void KEditListWidgetPrivate::insertEntry(int row, const QString &text)
+{
+    countEntry(text, 1);
+    updatingModel = true;
+    model->insertRows(row, 1);
+    model->setData(model->index(row), text);
+    updatingModel = false;
+
+    // As when the whole list was set again, which this replaced, nothing stays selected
+    listView->selectionModel()->reset();
+}
+
 void KEditListWidgetPrivate::setEditor(QLineEdit *newLineEdit, QWidget *representationWidget)
 {
     if (editingWidget != lineEdit && editingWidget != representationWidget) {
@@ -345,7 +417,7 @@ void KEditListWidget::typedSomething(const QString &text)
             d->listView->blockSignals(true);
             QModelIndex currentIndex = d->selectedIndex();
             if (currentIndex.isValid()) {
-                d->model->setData(currentIndex, text);
+                d->setEntry(currentIndex, text);
             }
             d->listView->blockSignals(block);
             Q_EMIT changed();
@@ -367,8 +439,7 @@ void KEditListWidget::typedSomething(const QString &text)
         if (text.isEmpty()) {
             d->servNewButton->setEnabled(false);
         } else {
-            QStringList list = d->model->stringList();
-            bool enable = !list.contains(text, Qt::CaseSensitive);
+            bool enable = !d->containsEntry(text);
             d->servNewButton->setEnabled(enable);
         }
     }
@@ -391,8 +462,8 @@ void KEditListWidget::moveItemUp()
         QModelIndex aboveIndex = d->model->index(index.row() - 1, index.column());
 
         QString tmp = d->model->data(aboveIndex, Qt::DisplayRole).toString();
-        d->model->setData(aboveIndex, d->model->data(index, Qt::DisplayRole));
-        d->model->setData(index, tmp);
+        d->setEntry(aboveIndex, d->model->data(index, Qt::DisplayRole).toString());
+        d->setEntry(index, tmp);
 
         d->listView->selectionModel()->select(index, QItemSelectionModel::Deselect);
         d->listView->selectionModel()->select(aboveIndex, QItemSelectionModel::Select);
@@ -418,8 +489,8 @@ void KEditListWidget::moveItemDown()
         QModelIndex belowIndex = d->model->index(index.row() + 1, index.column());
 
         QString tmp = d->model->data(belowIndex, Qt::DisplayRole).toString();
-        d->model->setData(belowIndex, d->model->data(index, Qt::DisplayRole));
-        d->model->setData(index, tmp);
+        d->setEntry(belowIndex, d->model->data(index, Qt::DisplayRole).toString());
+        d->setEntry(index, tmp);
 
         d->listView->selectionModel()->select(index, QItemSelectionModel::Deselect);
         d->listView->selectionModel()->select(belowIndex, QItemSelectionModel::Select);
@@ -449,7 +520,7 @@ void KEditListWidget::addItem()
                 alreadyInList = true;
             }
         } else {
-            alreadyInList = d->model->stringList().contains(currentTextLE, Qt::CaseSensitive);
+            alreadyInList = d->containsEntry(currentTextLE);
         }
     }
     if (d->servNewButton) {
@@ -475,12 +546,9 @@ void KEditListWidget::addItem()
         block = d->listView->signalsBlocked();
 
         if (currentIndex.isValid()) {
-            d->model->setData(currentIndex, currentTextLE);
+            d->setEntry(currentIndex, currentTextLE);
         } else {
-            QStringList lst;
-            lst << currentTextLE;
-            lst << d->model->stringList();
-            d->model->setStringList(lst);
+            d->insertEntry(0, currentTextLE);
         }
         Q_EMIT changed();
         Q_EMIT added(currentTextLE); // TODO: pass the index too
@@ -517,7 +585,10 @@ void KEditListWidget::removeItem()
 
         QString removedText = d->model->data(currentIndex, Qt::DisplayRole).toString();
 
+        d->countEntry(removedText, -1);
+        d->updatingModel = true;
         d->model->removeRows(currentIndex.row(), 1);
+        d->updatingModel = false;
 
         d->listView->selectionModel()->clear();
 
@@ -565,6 +636,8 @@ void KEditListWidget::clear()
 {
     d->lineEdit->clear();
     d->model->setStringList(QStringList());
+    d->entryCounts.clear();
+    d->entryCountsValid = true;
     Q_EMIT changed();
 }
 
@@ -579,27 +652,24 @@ void KEditListWidget::insertStringList(const QStringList &list, int index)
         }
     }
 
+    // One reset for the whole list
+    for (const QString &text : list) {
+        d->countEntry(text, 1);
+    }
+    d->updatingModel = true;
     d->model->setStringList(content);
+    d->updatingModel = false;
 }
 
 void KEditListWidget::insertItem(const QString &text, int index)
 {
-    QStringList list = d->model->stringList();
-
-    if (index < 0) {
-        list.append(text);
-    } else {
-        list.insert(index, text);
-    }
-
-    d->model->setStringList(list);
+    const int rowCount = d->model->rowCount();
+    d->insertEntry(index < 0 || index > rowCount ? rowCount : index, text);
 }
 
 QString KEditListWidget::text(int index) const
 {
-    const QStringList list = d->model->stringList();
-
-    return list[index];
+    return d->model->data(d->model->index(index), Qt::DisplayRole).toString();
 }
 
 QString KEditListWidget::currentText() const
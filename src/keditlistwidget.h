@@ -178,6 +178,8 @@ public:
     /*!
      * Inserts a \a text element at the \a index position
      * If \a index is negative, the element will be appended
+     *
+     * Like insertStringList(), this clears the selection.
      */
     void insertItem(const QString &text, int index = -1);
 
@@ -17,12 +17,85 @@
 
 #include "kfontaction.h"
 
+#include "fontcatalog_p.h"
 #include "kselectaction_p.h"
 
+#include <QApplication>
+#include <QComboBox>
 #include <QFontComboBox>
+#include <QFontDatabase>
+#include <QHash>
+#include <QIdentityProxyModel>
+#include <QListView>
+#include <QPainter>
+#include <QPixmapCache>
+#include <QStringListModel>
+#include <QStyledItemDelegate>
 
 #include <kfontchooser.h>
 
+#include <algorithm>
+
+// Renders each family name in its own font.
+// The view only paints the visible rows, and the rendered names are kept in
+// the global pixmap cache, so scrolling through the list does not need to
+// lay out text in hundreds of different fonts again and again.
+class KFontFamilyDelegate : public QStyledItemDelegate
+{
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        QStyleOptionViewItem opt = option;
+        initStyleOption(&opt, index);
+        const QString family = opt.text;
+        opt.text.clear();
+
+        const QWidget *widget = opt.widget;
+        QStyle *style = widget ? widget->style() : QApplication::style();
+        style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+        const QRect textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget);
+        if (family.isEmpty() || textRect.isEmpty()) {
+            return;
+        }
+
+        const QColor color = opt.palette.color(opt.state & QStyle::State_Enabled ? QPalette::Normal : QPalette::Disabled,
+                                               opt.state & QStyle::State_Selected ? QPalette::HighlightedText : QPalette::Text);
+        const qreal dpr = painter->device()->devicePixelRatioF();
+        const QString key = QLatin1String("kfontaction_") + family + QLatin1Char('_') + QString::number(textRect.width()) + QLatin1Char('x')
+            + QString::number(textRect.height()) + QLatin1Char('@') + QString::number(dpr) + QLatin1Char('_') + QString::number(color.rgba(), 16)
+            + QLatin1Char('_') + QString::number(opt.font.pointSizeF());
+
+        QPixmap pixmap;
+        if (!QPixmapCache::find(key, &pixmap)) {
+            QFont font(family);
+            font.setPointSizeF(opt.font.pointSizeF());
+            // Symbol fonts cannot show their own name, fall back to the default font then
+            const QFontMetrics fm(font);
+            const bool canShowName = std::all_of(family.cbegin(), family.cend(), [&fm](QChar c) {
+                return fm.inFont(c);
+            });
+            if (!canShowName) {
+                font = opt.font;
+            }
+
+            pixmap = QPixmap(textRect.size() * dpr);
+            pixmap.setDevicePixelRatio(dpr);
+            pixmap.fill(Qt::transparent);
+            QPainter p(&pixmap);
+            p.setFont(font);
+            p.setPen(color);
+            const QRect rect(QPoint(0, 0), textRect.size());
+            p.drawText(rect, Qt::AlignVCenter | Qt::AlignLeading, QFontMetrics(font).elidedText(family, Qt::ElideRight, rect.width()));
+            p.end();
+            QPixmapCache::insert(key, pixmap);
+        }
+        painter->drawPixmap(textRect.topLeft(), pixmap);
+    }
+};
+
 class KFontActionPrivate : public KSelectActionPrivate
 {
     Q_DECLARE_PUBLIC(KFontAction)
@@ -33,17 +106,20 @@ public:
     {
     }
 
-    void slotFontChanged(const QFont &font)
+    void init(const QStringList &families);
+    void updateFamilies();
+    int rowForFamily(const QString &family);
+
+    void slotFontChanged(const QString &fontFamily)
     {
         Q_Q(KFontAction);
 
-        //        qCDebug(KWidgetsAddonsLog) << "QFontComboBox - slotFontChanged("
-        //                 << font.family() << ") settingFont=" << settingFont;
-        if (settingFont) {
+        //        qCDebug(KWidgetsAddonsLog) << "QComboBox - slotFontChanged("
+        //                 << fontFamily << ") settingFont=" << settingFont;
+        if (settingFont || fontFamily.isEmpty()) {
             return;
         }
 
-        const QString fontFamily = font.family();
         q->setFont(fontFamily);
         Q_EMIT q->textTriggered(fontFamily);
 
@@ -52,6 +128,12 @@ public:
 
     int settingFont = 0;
     QFontComboBox::FontFilters fontFilters = QFontComboBox::AllFonts;
+
+    // Shared by all the combo boxes created for this action
+    QStringListModel *familyModel = nullptr;
+    QStringList families;
+    // Lowercase family name -> row in familyModel, built on first lookup
+    QHash<QString, int> familyRows;
 };
 
 QStringList fontList(const QFontComboBox::FontFilters &fontFilters = QFontComboBox::AllFonts)
@@ -84,6 +166,61 @@ QStringList fontList(const QFontComboBox::FontFilters &fontFilters = QFontComboB
     return families;
 }
 
+void KFontActionPrivate::init(const QStringList &fontFamilies)
+{
+    Q_Q(KFontAction);
+
+    families = fontFamilies;
+    q->KSelectAction::setItems(families);
+    q->setEditable(true);
+
+    QObject::connect(KFontCatalog::self(), &KFontCatalog::changed, q, [this]() {
+        updateFamilies();
+    });
+}
+
+void KFontActionPrivate::updateFamilies()
+{
+    Q_Q(KFontAction);
+
+    const QString currentFamily = q->font();
+
+    settingFont++;
+    families = fontList(fontFilters);
+    familyRows.clear();
+    if (familyModel) {
+        familyModel->setStringList(families);
+    }
+    q->KSelectAction::setItems(families);
+    settingFont--;
+
+    if (!currentFamily.isEmpty()) {
+        q->setFont(currentFamily);
+    }
+}
+
+int KFontActionPrivate::rowForFamily(const QString &family)
+{
+    if (familyRows.isEmpty()) {
+        familyRows.reserve(families.size());
+        for (int row = 0; row < families.size(); ++row) {
+            familyRows.insert(families.at(row).toLower(), row);
+        }
+    }
+
+    QString lowerName = family.toLower();
+    auto it = familyRows.constFind(lowerName);
+    if (it == familyRows.cend()) {
+        // Match "Family [Foundry]" against plain "Family" entries
+        const int i = lowerName.indexOf(QLatin1String(" ["));
+        if (i > -1) {
+            lowerName.truncate(i);
+            it = familyRows.constFind(lowerName);
+        }
+    }
+    return it != familyRows.cend() ? *it : -1;
+}
+
 KFontAction::KFontAction(uint fontListCriteria, QObject *parent)
     : KSelectAction(*new KFontActionPrivate(this), parent)
 {
@@ -97,32 +234,34 @@ KFontAction::KFontAction(uint fontListCriteria, QObject *parent)
         d->fontFilters |= QFontComboBox::ScalableFonts;
     }
 
-    KSelectAction::setItems(fontList(d->fontFilters));
-    setEditable(true);
+    d->init(fontList(d->fontFilters));
 }
 
 KFontAction::KFontAction(QObject *parent)
     : KSelectAction(*new KFontActionPrivate(this), parent)
 {
-    KSelectAction::setItems(fontList());
-    setEditable(true);
+    Q_D(KFontAction);
+
+    d->init(fontList());
 }
 
 KFontAction::KFontAction(const QString &text, QObject *parent)
     : KSelectAction(*new KFontActionPrivate(this), parent)
 {
+    Q_D(KFontAction);
+
     setText(text);
-    KSelectAction::setItems(fontList());
-    setEditable(true);
+    d->init(fontList());
 }
 
 KFontAction::KFontAction(const QIcon &icon, const QString &text, QObject *parent)
     : KSelectAction(*new KFontActionPrivate(this), parent)
 {
     setIcon(icon);
+    Q_D(KFontAction);
+
     setText(text);
-    KSelectAction::setItems(fontList());
-    setEditable(true);
+    d->init(fontList());
 }
 
 KFontAction::~KFontAction() = default;
@@ -141,25 +280,43 @@ QWidget *KFontAction::createWidget(QWidget *parent)
     // This is the visual element on the screen.  This method overrides
     // the KSelectAction one, preventing KSelectAction from creating its
     // regular KComboBox.
+    // All combo boxes share the family model of the action, so creating
+    // another one does not enumerate the font database again.
+    if (!d->familyModel) {
+        d->familyModel = new QStringListModel(d->families, this);
+    }
+
+    // Still a QFontComboBox, for callers which use its API on the created widget.
+    // It shows the shared list through a proxy, QFontComboBox only refills a
+    // QStringListModel, so the list keeps following the filters of the action.
     QFontComboBox *cb = new QFontComboBox(parent);
+    cb->setEditable(true);
+    cb->setInsertPolicy(QComboBox::NoInsert);
+    auto *proxyModel = new QIdentityProxyModel(cb);
+    proxyModel->setSourceModel(d->familyModel);
+    cb->setModel(proxyModel);
+    // Only reported back by fontFilters() now, the list is not read again
     cb->setFontFilters(d->fontFilters);
+    cb->setItemDelegate(new KFontFamilyDelegate(cb));
+    if (auto *view = qobject_cast<QListView *>(cb->view())) {
+        view->setUniformItemSizes(true);
+    }
+    // Avoid measuring every family name for the size hint
+    cb->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
+    cb->setMinimumContentsLength(14);
 
     //    qCDebug(KWidgetsAddonsLog) << "\tset=" << font();
     // Do this before connecting the signal so that nothing will fire.
-    cb->setCurrentFont(QFont(font().toLower()));
-    //    qCDebug(KWidgetsAddonsLog) << "\tspit back=" << cb->currentFont().family();
+    cb->setCurrentIndex(d->rowForFamily(font()));
 
-    connect(cb, &QFontComboBox::currentFontChanged, this, [this](const QFont &ft) {
+    connect(cb, &QComboBox::currentIndexChanged, this, [this, cb](int index) {
         Q_D(KFontAction);
-        d->slotFontChanged(ft);
+        d->slotFontChanged(cb->itemText(index));
     });
     cb->setMinimumWidth(cb->sizeHint().width());
     return cb;
 }
 
-/*
- * Maintenance note: Keep in sync with QFontComboBox::setCurrentFont()
- */
 void KFontAction::setFont(const QString &family)
 {
     Q_D(KFontAction);
@@ -169,17 +326,23 @@ void KFontAction::setFont(const QString &family)
     // Suppress triggered(QString) signal and prevent recursive call to ourself.
     d->settingFont++;
 
+    const int row = d->rowForFamily(family);
     const auto createdWidgets = this->createdWidgets();
     for (QWidget *w : createdWidgets) {
-        QFontComboBox *cb = qobject_cast<QFontComboBox *>(w);
+        QComboBox *cb = qobject_cast<QComboBox *>(w);
         //        qCDebug(KWidgetsAddonsLog) << "\tw=" << w << "cb=" << cb;
 
         if (!cb) {
             continue;
         }
 
-        cb->setCurrentFont(QFont(family.toLower()));
-        //        qCDebug(KWidgetsAddonsLog) << "\t\tw spit back=" << cb->currentFont().family();
+        if (row >= 0) {
+            cb->setCurrentIndex(row);
+        } else {
+            cb->setCurrentIndex(-1);
+            cb->setEditText(family);
+        }
+        //        qCDebug(KWidgetsAddonsLog) << "\t\tw spit back=" << cb->currentText();
     }
 
     d->settingFont--;
@@ -205,7 +368,7 @@ void KFontAction::setFont(const QString &family)
         return;
     }
 
-    // TODO: Inconsistent state if QFontComboBox::setCurrentFont() succeeded
+    // TODO: Inconsistent state if the combo boxes found the family
     //       but setCurrentAction() did not and vice-versa.
     //    qCDebug(KWidgetsAddonsLog) << "Font not found " << family.toLower();
 }
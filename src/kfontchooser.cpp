@@ -7,6 +7,7 @@
 */
 
 #include "kfontchooser.h"
+#include "fontcatalog_p.h"
 #include "fonthelpers_p.h"
 #include "ui_kfontchooserwidget.h"
 
@@ -94,7 +95,6 @@ public:
     qreal setupSizeListBox(const QString &family, const QString &style);
 
     void setupDisplay();
-    QString styleIdentifier(const QFont &font);
 
     void slotFamilySelected(const QString &);
     void slotSizeSelected(const QString &);
@@ -387,17 +387,6 @@ QFont KFontChooser::font() const
     return d->m_selectedFont;
 }
 
-static bool isDefaultFontStyleName(const QString &style)
-{
-    /* clang-format off */
-    // Ordered by commonness, i.e. "Regular" is the most common
-    return style == QLatin1String("Regular")
-        || style == QLatin1String("Normal")
-        || style == QLatin1String("Book")
-        || style == QLatin1String("Roman");
-    /* clang-format on */
-}
-
 void KFontChooserPrivate::slotFamilySelected(const QString &family)
 {
     if (!m_signalsAllowed) {
@@ -415,51 +404,18 @@ void KFontChooserPrivate::slotFamilySelected(const QString &family)
         currentFamily = m_qtFamilies[family];
     }
 
-    // Get the list of styles available in this family.
-    QStringList styles = QFontDatabase::styles(currentFamily);
-    if (styles.isEmpty()) {
-        // Avoid extraction, it is in kdeqt.po
-        styles.append(TR_NOX("Normal", "QFontDatabase"));
-    }
-
-    // Always prepend Regular, Normal, Book or Roman, this way if "m_selectedStyle"
-    // in the code below is empty, selecting index 0 should work better
-    std::sort(styles.begin(), styles.end(), [](const QString &a, const QString &b) {
-        if (isDefaultFontStyleName(a)) {
-            return true;
-        } else if (isDefaultFontStyleName(b)) {
-            return false;
-        }
-        return false;
-    });
-
-    // Filter style strings and add to the listbox.
-    QString pureFamily;
-    splitFontString(family, &pureFamily);
+    // Styles are resolved once per family and shared by all font choosers.
+    const QList<KFontCatalog::Style> styles = KFontCatalog::self()->styles(currentFamily);
     QStringList filteredStyles;
+    filteredStyles.reserve(styles.size());
     m_qtStyles.clear();
     m_styleIDs.clear();
-
-    const QStringList origStyles = styles;
-    for (const QString &style : origStyles) {
-        // Sometimes the font database will report an invalid style,
-        // that falls back back to another when set.
-        // Remove such styles, by checking set/get round-trip.
-        QFont testFont = QFontDatabase::font(currentFamily, style, 10);
-        if (QFontDatabase::styleString(testFont) != style) {
-            styles.removeAll(style);
-            continue;
-        }
-
-        QString fstyle = tr("%1", "@item Font style").arg(style);
-        if (!filteredStyles.contains(fstyle)) {
-            filteredStyles.append(fstyle);
-            m_qtStyles.insert({fstyle, style});
-            m_styleIDs.insert({fstyle, styleIdentifier(testFont)});
-        }
+    for (const KFontCatalog::Style &style : styles) {
+        filteredStyles.append(style.text);
+        m_qtStyles.insert({style.text, style.name});
+        m_styleIDs.insert({style.text, style.identifier});
     }
-    m_ui->styleListWidget->clear();
-    m_ui->styleListWidget->addItems(filteredStyles);
+    syncListItems(m_ui->styleListWidget, filteredStyles);
 
     // Try to set the current style in the listbox to that previous.
     int listPos = filteredStyles.indexOf(m_selectedStyle.isEmpty() ? TR_NOX("Normal", "QFontDatabase") : m_selectedStyle);
@@ -489,7 +445,7 @@ void KFontChooserPrivate::slotFamilySelected(const QString &family)
     m_ui->sizeSpinBox->setValue(currentSize);
 
     m_selectedFont = QFontDatabase::font(currentFamily, currentStyle, static_cast<int>(currentSize));
-    if (QFontDatabase::isSmoothlyScalable(currentFamily, currentStyle) && m_selectedFont.pointSize() == floor(currentSize)) {
+    if (KFontCatalog::self()->isSmoothlyScalable(currentFamily, currentStyle) && m_selectedFont.pointSize() == floor(currentSize)) {
         m_selectedFont.setPointSizeF(currentSize);
     }
     Q_EMIT q->fontSelected(m_selectedFont);
@@ -512,7 +468,7 @@ void KFontChooserPrivate::slotStyleSelected(const QString &style)
     m_ui->sizeSpinBox->setValue(currentSize);
 
     m_selectedFont = QFontDatabase::font(currentFamily, currentStyle, static_cast<int>(currentSize));
-    if (QFontDatabase::isSmoothlyScalable(currentFamily, currentStyle) && m_selectedFont.pointSize() == floor(currentSize)) {
+    if (KFontCatalog::self()->isSmoothlyScalable(currentFamily, currentStyle) && m_selectedFont.pointSize() == floor(currentSize)) {
         m_selectedFont.setPointSizeF(currentSize);
     }
     Q_EMIT q->fontSelected(m_selectedFont);
@@ -578,7 +534,7 @@ void KFontChooserPrivate::slotSizeValue(double dval)
     const QString style = m_qtStyles[m_ui->styleListWidget->currentItem()->text()];
 
     // For Qt-bad-sizes workaround: skip this block unconditionally
-    if (!QFontDatabase::isSmoothlyScalable(family, style)) {
+    if (!KFontCatalog::self()->isSmoothlyScalable(family, style)) {
         // Bitmap font, allow only discrete sizes.
         // Determine the nearest in the direction of change.
         canCustomize = false;
@@ -694,11 +650,13 @@ qreal KFontChooserPrivate::fillSizeList(const QList<qreal> &sizes_)
     }
 
     // Insert sizes into the listbox.
-    m_ui->sizeListWidget->clear();
     std::sort(sizes.begin(), sizes.end());
+    QStringList sizeTexts;
+    sizeTexts.reserve(sizes.size());
     for (qreal size : std::as_const(sizes)) {
-        m_ui->sizeListWidget->addItem(formatFontSize(size));
+        sizeTexts.append(formatFontSize(size));
     }
+    syncListItems(m_ui->sizeListWidget, sizeTexts);
 
     // Return the nearest to selected size.
     // If the font is vector, the nearest size is always same as selected,
@@ -712,18 +670,9 @@ qreal KFontChooserPrivate::fillSizeList(const QList<qreal> &sizes_)
 
 qreal KFontChooserPrivate::setupSizeListBox(const QString &family, const QString &style)
 {
-    QList<qreal> sizes;
-    const bool smoothlyScalable = QFontDatabase::isSmoothlyScalable(family, style);
-    if (!smoothlyScalable) {
-        const QList<int> smoothSizes = QFontDatabase::smoothSizes(family, style);
-        for (int size : smoothSizes) {
-            sizes.append(size);
-        }
-    }
-
     // Fill the listbox (uses default list of sizes if the given is empty).
     // Collect the best fitting size to selected size, to use if not smooth.
-    qreal bestFitSize = fillSizeList(sizes);
+    qreal bestFitSize = fillSizeList(KFontCatalog::self()->sizes(family, style).sizes);
 
     // Set the best fit size as current in the listbox if available.
     const QList<QListWidgetItem *> selectedSizeList = m_ui->sizeListWidget->findItems(formatFontSize(bestFitSize), Qt::MatchExactly);
@@ -760,7 +709,7 @@ void KFontChooserPrivate::setupDisplay()
 
     // Get the styleID here before familyListWidget->setCurrentRow() is called
     // as it may change the font style
-    const QString styleID = styleIdentifier(m_selectedFont);
+    const QString styleID = KFontCatalog::styleIdentifier(m_selectedFont);
 
     QString family = m_selectedFont.family().toLower();
     // Direct family match.
@@ -834,7 +783,7 @@ void KFontChooserPrivate::setupDisplay()
     // otherwise just select the nearest available size.
     const QString currentFamily = m_qtFamilies[m_ui->familyListWidget->currentItem()->text()];
     const QString currentStyle = m_qtStyles[m_ui->styleListWidget->currentItem()->text()];
-    const bool canCustomize = QFontDatabase::isSmoothlyScalable(currentFamily, currentStyle);
+    const bool canCustomize = KFontCatalog::self()->isSmoothlyScalable(currentFamily, currentStyle);
     m_ui->sizeListWidget->setCurrentRow(nearestSizeRow(size, canCustomize));
 
     // Set current size in the spinbox.
@@ -931,39 +880,4 @@ void KFontChooser::setMinVisibleItems(int visibleItems)
     }
 }
 
-// Human-readable style identifiers returned by QFontDatabase::styleString()
-// do not always survive round trip of QFont serialization/deserialization,
-// causing wrong style in the style box to be highlighted when
-// the chooser dialog is opened. This will cause the style to be changed
-// when the dialog is closed and the user did not touch the style box.
-// Hence, construct custom style identifiers sufficient for the purpose.
-QString KFontChooserPrivate::styleIdentifier(const QFont &font)
-{
-    const int weight = font.weight();
-    QString styleName = font.styleName();
-    // If the styleName property is empty and the weight is QFont::Normal, that
-    // could mean it's a "Regular"-like style with the styleName part stripped
-    // so that subsequent calls to setBold(true) can work properly (i.e. selecting
-    // the "Bold" style provided by the font itself) without resorting to font
-    // "emboldening" which looks ugly.
-    // See also KConfigGroupGui::writeEntryGui().
-    if (styleName.isEmpty() && weight == QFont::Normal) {
-        const QStringList styles = QFontDatabase::styles(font.family());
-        for (const QString &style : styles) {
-            if (isDefaultFontStyleName(style)) {
-                styleName = style;
-                break;
-            } else {
-                // nothing more we can do
-            }
-        }
-    }
-
-    const QChar comma(QLatin1Char(','));
-    return QString::number(weight) + comma //
-        + QString::number((int)font.style()) + comma //
-        + QString::number(font.stretch()) + comma //
-        + styleName;
-}
-
 #include "moc_kfontchooser.cpp"
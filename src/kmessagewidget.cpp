@@ -16,6 +16,7 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPainter>
+#include <QPixmap>
 #include <QShowEvent>
 #include <QStyle>
 #include <QStyleOption>
@@ -44,6 +45,14 @@ public:
     bool wordWrap;
     QList<QToolButton *> buttons;
     bool ignorePaletteChange = false;
+    // While animating, the content is painted from this snapshot and the
+    // layout is disabled. The height is reserved once and the frames only
+    // reveal more or less of the snapshot, so a frame costs neither a relayout
+    // of the parent nor a repaint of the child widgets.
+    QPixmap contentSnapshot;
+    int animationTargetHeight = 0;
+    bool capturingSnapshot = false;
+    bool snapshotStale = false;
 
     void createLayout();
     void setPalette();
@@ -51,6 +60,9 @@ public:
     void slotTimeLineChanged(qreal);
     void slotTimeLineFinished();
     int bestContentHeight() const;
+    void beginSnapshot();
+    void endSnapshot();
+    bool isPaintingSnapshot() const;
 };
 
 void KMessageWidgetPrivate::init(KMessageWidget *q_ptr)
@@ -153,7 +165,10 @@ void KMessageWidgetPrivate::createLayout()
     };
     // Add bordersize to the margin so it starts from the inner border and doesn't look too cramped
     q->layout()->setContentsMargins(q->layout()->contentsMargins() + borderSize);
-    if (q->isVisible()) {
+    if (!contentSnapshot.isNull()) {
+        // Keep the reserved height while animating, the snapshot is taken again on the next frame
+        snapshotStale = true;
+    } else if (q->isVisible()) {
         q->setFixedHeight(q->sizeHint().height());
     }
     q->updateGeometry();
@@ -204,19 +219,30 @@ void KMessageWidgetPrivate::updateLayout()
 
 void KMessageWidgetPrivate::slotTimeLineChanged(qreal value)
 {
-    q->setFixedHeight(qMin(value * 2, qreal(1.0)) * bestContentHeight());
+    Q_UNUSED(value)
+    if (snapshotStale) {
+        // The width or the content changed, the content has to be laid out again
+        endSnapshot();
+        beginSnapshot();
+    }
+    if (q->height() != animationTargetHeight) {
+        // Reserve the space once, paintEvent() reveals the snapshot
+        q->setFixedHeight(animationTargetHeight);
+    }
     q->update();
 }
 
 void KMessageWidgetPrivate::slotTimeLineFinished()
 {
     if (timeLine->direction() == QTimeLine::Forward) {
+        endSnapshot();
         q->resize(q->width(), bestContentHeight());
 
         // notify about finished animation
         Q_EMIT q->showAnimationFinished();
     } else {
         // hide and notify about finished animation
+        q->setFixedHeight(0);
         q->hide();
         Q_EMIT q->hideAnimationFinished();
     }
@@ -231,6 +257,58 @@ int KMessageWidgetPrivate::bestContentHeight() const
     return height;
 }
 
+void KMessageWidgetPrivate::beginSnapshot()
+{
+    if (!contentSnapshot.isNull()) {
+        return;
+    }
+
+    // Lay out and render the content once at its final size.
+    // Only the animation changes the height of a visible widget afterwards.
+    capturingSnapshot = true;
+    animationTargetHeight = bestContentHeight();
+    q->setFixedHeight(animationTargetHeight);
+    QLayout *layout = q->layout();
+    if (layout) {
+        layout->invalidate();
+        layout->activate();
+    }
+    contentSnapshot = q->grab();
+    capturingSnapshot = false;
+    snapshotStale = false;
+
+    if (layout) {
+        layout->setEnabled(false);
+    }
+    // Park the children below the visible area, the snapshot stands in for them.
+    // Moving them keeps their visibility untouched, so no layout request is posted.
+    const QPoint offset(0, animationTargetHeight);
+    const auto children = q->findChildren<QWidget *>(Qt::FindDirectChildrenOnly);
+    for (QWidget *child : children) {
+        child->move(child->pos() + offset);
+    }
+}
+
+void KMessageWidgetPrivate::endSnapshot()
+{
+    if (contentSnapshot.isNull()) {
+        return;
+    }
+
+    contentSnapshot = QPixmap();
+    snapshotStale = false;
+    if (QLayout *layout = q->layout()) {
+        layout->setEnabled(true);
+        layout->invalidate();
+        layout->activate();
+    }
+}
+
+bool KMessageWidgetPrivate::isPaintingSnapshot() const
+{
+    return !contentSnapshot.isNull() && !capturingSnapshot;
+}
+
 //---------------------------------------------------------------------
 // KMessageWidget
 //---------------------------------------------------------------------
@@ -316,6 +394,10 @@ bool KMessageWidget::event(QEvent *event)
         d->createLayout();
     } else if ((event->type() == QEvent::Show && !d->ignoreShowAndResizeEventDoingAnimatedShow)
                || (event->type() == QEvent::LayoutRequest && d->timeLine->state() == QTimeLine::NotRunning)) {
+        if (event->type() == QEvent::Show) {
+            // A finished hide animation leaves the content in snapshot mode
+            d->endSnapshot();
+        }
         setFixedHeight(d->bestContentHeight());
 
         // if we are displaying this when application first starts, there's
@@ -343,6 +425,9 @@ bool KMessageWidget::event(QEvent *event)
 void KMessageWidget::resizeEvent(QResizeEvent *event)
 {
     QFrame::resizeEvent(event);
+    if (!d->contentSnapshot.isNull() && event->size().width() != event->oldSize().width()) {
+        d->snapshotStale = true;
+    }
     if (d->timeLine->state() == QTimeLine::NotRunning && d->ignoreShowAndResizeEventDoingAnimatedShow) {
         setFixedHeight(d->bestContentHeight());
     }
@@ -351,6 +436,10 @@ void KMessageWidget::resizeEvent(QResizeEvent *event)
 int KMessageWidget::heightForWidth(int width) const
 {
     ensurePolished();
+    if (d->isPaintingSnapshot() && d->timeLine->state() == QTimeLine::Running) {
+        // The layout is disabled while animating, the height is driven by the timeline
+        return height();
+    }
     return QFrame::heightForWidth(width);
 }
 
@@ -358,8 +447,14 @@ void KMessageWidget::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
     QPainter painter(this);
-    if (d->timeLine->state() == QTimeLine::Running) {
-        painter.setOpacity(d->timeLine->currentValue() * d->timeLine->currentValue());
+    if (d->isPaintingSnapshot()) {
+        if (d->timeLine->state() == QTimeLine::Running) {
+            const qreal value = d->timeLine->currentValue();
+            painter.setOpacity(value * value);
+            painter.setClipRect(0, 0, width(), qRound(qMin(value * 2, qreal(1.0)) * d->animationTargetHeight));
+        }
+        painter.drawPixmap(0, 0, d->contentSnapshot);
+        return;
     }
     constexpr float radius = 4 * 0.6;
     const QRect innerRect = rect().marginsRemoved(QMargins() + borderSize / 2);
@@ -473,6 +568,12 @@ void KMessageWidget::animatedShow()
         return;
     }
 
+    if (d->timeLine->state() == QTimeLine::NotRunning) {
+        // The content might have changed since a previous hide animation
+        d->endSnapshot();
+    }
+    // Taken before showing, the parent is told about the collapsed widget once
+    d->beginSnapshot();
     d->ignoreShowAndResizeEventDoingAnimatedShow = true;
     show();
     d->ignoreShowAndResizeEventDoingAnimatedShow = false;
@@ -507,6 +608,7 @@ void KMessageWidget::animatedHide()
         return;
     }
 
+    d->beginSnapshot();
     d->timeLine->setDirection(QTimeLine::Backward);
     if (d->timeLine->state() == QTimeLine::NotRunning) {
         d->timeLine->start();
@@ -6,6 +6,7 @@
 
 #include "kmultitabbar.h"
 #include "kmultitabbar_p.h"
+#include "kwidgetsaddonstiming_p.h"
 #include "moc_kmultitabbar.cpp"
 #include "moc_kmultitabbar_p.cpp"
 
@@ -347,6 +348,7 @@ bool KMultiTabBarTab::isVertical() const
 
 void KMultiTabBarTab::paintEvent(QPaintEvent *)
 {
+    const KWidgetsAddonsTiming::ScopedTimer timer("KMultiTabBarTab", KWidgetsAddonsTiming::Paint);
     QPainter painter(this);
 
     QStyleOptionToolButton opt;
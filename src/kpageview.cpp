@@ -14,6 +14,7 @@
 #include "common_helpers_p.h"
 #include "kpagemodel.h"
 #include "kpagewidgetmodel.h"
+#include "kwidgetsaddonstiming_p.h"
 #include "loggingcategory.h"
 
 #include <ktitlewidget.h>
@@ -617,6 +618,7 @@ void KPageViewPrivate::onSearchTextChanged()
         return;
     }
 
+    const KWidgetsAddonsTiming::ScopedTimer timer("KPageView", KWidgetsAddonsTiming::ModelQuery);
     const QString text = searchLineEdit->text();
     QSet<QString> pagesToHide;
     std::vector<QWidget *> matchedWidgets;
@@ -10,15 +10,55 @@
 #include <QApplication>
 #include <QColor>
 #include <QCursor>
+#include <QFutureInterface>
+#include <QFutureWatcher>
 #include <QHBoxLayout>
 #include <QImage>
-#include <QLabel>
 #include <QMenu>
 #include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
 #include <QRubberBand>
+#include <QThreadPool>
 #include <QVBoxLayout>
 
+class RunRotation : public QFutureInterface<QImage>, public QRunnable
+{
+public:
+    RunRotation(const QImage &image, const QTransform &transform)
+        : m_image(image)
+        , m_transform(transform)
+    {
+    }
+
+    QFuture<QImage> start()
+    {
+        setRunnable(this);
+        reportStarted();
+        QFuture<QImage> f = this->future();
+        QThreadPool::globalInstance()->start(this);
+        return f;
+    }
+
+    void run() override
+    {
+        // Superseded by setPixmap() or by another rotation
+        if (!isCanceled()) {
+            const QImage image = m_image.transformed(m_transform);
+            if (!isCanceled()) {
+                reportResult(image);
+            }
+        }
+        reportFinished(nullptr);
+    }
+
+private:
+    const QImage m_image;
+    const QTransform m_transform;
+};
+
+class KPixmapRegionSelectorPreview;
+
 class KPixmapRegionSelectorWidgetPrivate
 {
 public:
@@ -30,11 +70,32 @@ public:
     KPixmapRegionSelectorWidget *const q;
 
     /*!
-     * Recalculates the pixmap that is shown based on the current selected area,
-     * the original image, etc.
+     * Schedules a repaint of the parts of the preview affected by a change
+     * of the selected area, and updates the rubber band.
      */
     void updatePixmap();
 
+    /*!
+     * To be called when m_originalPixmap changed, drops the darkened copy
+     * and resizes the preview.
+     */
+    void previewChanged();
+
+    const QPixmap &linedPixmap();
+
+    QTransform rotation() const
+    {
+        return QTransform().rotate(90.0 * m_quarterTurns);
+    }
+
+    // Size of m_unzoomedPixmap once rotated
+    QSize rotatedSize() const
+    {
+        return m_quarterTurns % 2 ? m_unzoomedPixmap.size().transposed() : m_unzoomedPixmap.size();
+    }
+
+    void startRotation();
+
     QRect calcSelectionRectangle(const QPoint &startPoint, const QPoint &endPoint);
 
     enum CursorState {
@@ -42,13 +103,24 @@ public:
         Resizing,
         Moving
     };
-    CursorState m_state;
+    CursorState m_state = None;
 
+    // The pixmap as set, rotations are only composed into m_quarterTurns,
+    // the rotated full resolution pixmap is computed in the background.
     QPixmap m_unzoomedPixmap;
+    int m_quarterTurns = 0;
+    // The rotated image is converted to a pixmap in pixmap(), only when asked for,
+    // so that the conversion of a large image does not stall the GUI thread when ready
+    QImage m_rotatedImage;
+    QPixmap m_rotatedPixmap;
+    QFutureWatcher<QImage> *m_rotationWatcher;
+    // The screen resolution preview of m_unzoomedPixmap, and its darkened copy
     QPixmap m_originalPixmap;
     QPixmap m_linedPixmap;
     QRect m_selectedRegion;
-    QLabel *m_label;
+    // The selected area as currently shown by the preview
+    QRect m_paintedRegion;
+    KPixmapRegionSelectorPreview *m_preview;
 
     QPoint m_tempFirstClick;
     double m_forcedAspectRatio;
@@ -59,6 +131,55 @@ public:
     QRubberBand *m_rubberBand;
 };
 
+/*
+ * Paints the preview straight from the darkened and the original pixmap,
+ * limited to the exposed area. Unlike a QLabel it needs no composed pixmap,
+ * so a selection change only costs repainting the area it affects.
+ */
+class KPixmapRegionSelectorPreview : public QWidget
+{
+public:
+    KPixmapRegionSelectorPreview(KPixmapRegionSelectorWidgetPrivate *d, QWidget *parent)
+        : QWidget(parent)
+        , d(d)
+    {
+        setAttribute(Qt::WA_OpaquePaintEvent);
+        setAttribute(Qt::WA_NoSystemBackground);
+        setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    }
+
+    QSize sizeHint() const override
+    {
+        return d->m_originalPixmap.size();
+    }
+
+    QSize minimumSizeHint() const override
+    {
+        return sizeHint();
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        if (d->m_originalPixmap.isNull()) {
+            return;
+        }
+
+        QPainter painter(this);
+        const QPixmap &linedPixmap = d->linedPixmap();
+        for (const QRect &rect : event->region()) {
+            painter.drawPixmap(rect.topLeft(), linedPixmap, rect);
+            const QRect selected = rect & d->m_paintedRegion;
+            if (!selected.isEmpty()) {
+                painter.drawPixmap(selected.topLeft(), d->m_originalPixmap, selected);
+            }
+        }
+    }
+
+private:
+    KPixmapRegionSelectorWidgetPrivate *const d;
+};
+
 KPixmapRegionSelectorWidget::KPixmapRegionSelectorWidget(QWidget *parent)
     : QWidget(parent)
     , d(new KPixmapRegionSelectorWidgetPrivate(this))
@@ -70,11 +191,10 @@ KPixmapRegionSelectorWidget::KPixmapRegionSelectorWidget(QWidget *parent)
     hboxLayout->addItem(vboxLayout);
 
     vboxLayout->addStretch();
-    d->m_label = new QLabel(this);
-    d->m_label->setAttribute(Qt::WA_NoSystemBackground, true); // setBackgroundMode( Qt::NoBackground );
-    d->m_label->installEventFilter(this);
+    d->m_preview = new KPixmapRegionSelectorPreview(d.get(), this);
+    d->m_preview->installEventFilter(this);
 
-    vboxLayout->addWidget(d->m_label);
+    vboxLayout->addWidget(d->m_preview);
     vboxLayout->addStretch();
 
     hboxLayout->addStretch();
@@ -82,15 +202,39 @@ KPixmapRegionSelectorWidget::KPixmapRegionSelectorWidget(QWidget *parent)
     d->m_forcedAspectRatio = 0;
 
     d->m_zoomFactor = 1.0;
-    d->m_rubberBand = new QRubberBand(QRubberBand::Rectangle, d->m_label);
+    d->m_rubberBand = new QRubberBand(QRubberBand::Rectangle, d->m_preview);
     d->m_rubberBand->hide();
+
+    d->m_rotationWatcher = new QFutureWatcher<QImage>(this);
+    connect(d->m_rotationWatcher, &QFutureWatcherBase::finished, this, [this]() {
+        // Rotations superseded by setPixmap() or by a rotation back to the original are canceled
+        if (d->m_rotationWatcher->isCanceled() || d->m_rotationWatcher->future().resultCount() == 0) {
+            return;
+        }
+        // pixmap() may have waited for the result already, keep a single copy
+        if (d->m_rotatedPixmap.isNull()) {
+            d->m_rotatedImage = d->m_rotationWatcher->result();
+        }
+        Q_EMIT rotatedPixmapReady();
+    });
 }
 
 KPixmapRegionSelectorWidget::~KPixmapRegionSelectorWidget() = default;
 
 QPixmap KPixmapRegionSelectorWidget::pixmap() const
 {
-    return d->m_unzoomedPixmap;
+    if (d->m_quarterTurns == 0) {
+        return d->m_unzoomedPixmap;
+    }
+    if (d->m_rotatedPixmap.isNull()) {
+        if (d->m_rotatedImage.isNull()) {
+            // Needed before the background rotation is done
+            d->m_rotatedImage = d->m_rotationWatcher->future().result();
+        }
+        d->m_rotatedPixmap = QPixmap::fromImage(std::move(d->m_rotatedImage));
+        d->m_rotatedImage = QImage();
+    }
+    return d->m_rotatedPixmap;
 }
 
 void KPixmapRegionSelectorWidget::setPixmap(const QPixmap &pixmap)
@@ -98,7 +242,11 @@ void KPixmapRegionSelectorWidget::setPixmap(const QPixmap &pixmap)
     Q_ASSERT(!pixmap.isNull()); // This class isn't designed to deal with null pixmaps.
     d->m_originalPixmap = pixmap;
     d->m_unzoomedPixmap = pixmap;
-    d->m_label->setPixmap(pixmap);
+    d->m_quarterTurns = 0;
+    d->m_rotatedImage = QImage();
+    d->m_rotatedPixmap = QPixmap();
+    d->m_rotationWatcher->cancel();
+    d->previewChanged();
     resetSelection();
 }
 
@@ -124,11 +272,44 @@ void KPixmapRegionSelectorWidget::setSelectedRegion(const QRect &rect)
     }
 }
 
+const QPixmap &KPixmapRegionSelectorWidgetPrivate::linedPixmap()
+{
+    if (m_linedPixmap.isNull()) {
+        m_linedPixmap = m_originalPixmap;
+        QPainter p(&m_linedPixmap);
+        p.setCompositionMode(QPainter::CompositionMode_SourceAtop);
+        p.fillRect(m_linedPixmap.rect(), QColor(0, 0, 0, 100));
+    }
+    return m_linedPixmap;
+}
+
+void KPixmapRegionSelectorWidgetPrivate::startRotation()
+{
+    m_rotatedImage = QImage();
+    m_rotatedPixmap = QPixmap();
+    // A rotation still running for a previous angle stops as soon as it can
+    m_rotationWatcher->cancel();
+    if (m_quarterTurns == 0) {
+        return;
+    }
+    m_rotationWatcher->setFuture((new RunRotation(m_unzoomedPixmap.toImage(), rotation()))->start());
+}
+
+void KPixmapRegionSelectorWidgetPrivate::previewChanged()
+{
+    m_linedPixmap = QPixmap();
+    m_paintedRegion = QRect();
+    m_preview->updateGeometry();
+    m_preview->update();
+    // Lay out now, callers rely on the new preview size
+    qApp->sendPostedEvents(nullptr, QEvent::LayoutRequest);
+}
+
 void KPixmapRegionSelectorWidgetPrivate::updatePixmap()
 {
     Q_ASSERT(!m_originalPixmap.isNull());
     if (m_originalPixmap.isNull()) {
-        m_label->setPixmap(m_originalPixmap);
+        m_preview->update();
         return;
     }
     if (m_selectedRegion.width() > m_originalPixmap.width()) {
@@ -138,30 +319,20 @@ void KPixmapRegionSelectorWidgetPrivate::updatePixmap()
         m_selectedRegion.setHeight(m_originalPixmap.height());
     }
 
-    QPainter painter;
-    if (m_linedPixmap.isNull()) {
-        m_linedPixmap = m_originalPixmap;
-        QPainter p(&m_linedPixmap);
-        p.setCompositionMode(QPainter::CompositionMode_SourceAtop);
-        p.fillRect(m_linedPixmap.rect(), QColor(0, 0, 0, 100));
+    // Only the area which changes between darkened and not needs repainting.
+    // The repaint itself is deferred, so the moves of a drag are coalesced
+    // into one paint per frame.
+    if (m_selectedRegion != m_paintedRegion) {
+        m_preview->update(QRegion(m_paintedRegion).xored(m_selectedRegion));
+        m_paintedRegion = m_selectedRegion;
     }
 
-    QPixmap pixmap = m_linedPixmap;
-    painter.begin(&pixmap);
-    painter.drawPixmap(m_selectedRegion.topLeft(), m_originalPixmap, m_selectedRegion);
-
-    painter.end();
-
-    m_label->setPixmap(pixmap);
-
-    qApp->sendPostedEvents(nullptr, QEvent::LayoutRequest);
-
-    if (m_selectedRegion == m_originalPixmap.rect()) { // d->m_label->rect()) //### CHECK!
+    if (m_selectedRegion == m_originalPixmap.rect()) { // d->m_preview->rect()) //### CHECK!
         m_rubberBand->hide();
     } else {
         m_rubberBand->setGeometry(QRect(m_selectedRegion.topLeft(), m_selectedRegion.size()));
 
-        /*        m_rubberBand->setGeometry(QRect(m_label -> mapToGlobal(m_selectedRegion.topLeft()),
+        /*        m_rubberBand->setGeometry(QRect(m_preview -> mapToGlobal(m_selectedRegion.topLeft()),
                                                 m_selectedRegion.size()));
         */
         if (m_state != None) {
@@ -196,18 +367,18 @@ void KPixmapRegionSelectorWidget::rotate(RotateDirection direction)
 {
     int w = d->m_originalPixmap.width();
     int h = d->m_originalPixmap.height();
-    QImage img = d->m_unzoomedPixmap.toImage();
     if (direction == Rotate90) {
-        img = img.transformed(QTransform().rotate(90.0));
+        d->m_quarterTurns += 1;
     } else if (direction == Rotate180) {
-        img = img.transformed(QTransform().rotate(180.0));
+        d->m_quarterTurns += 2;
     } else {
-        img = img.transformed(QTransform().rotate(270.0));
+        d->m_quarterTurns += 3;
     }
+    d->m_quarterTurns %= 4;
+    d->startRotation();
 
-    d->m_unzoomedPixmap = QPixmap::fromImage(img);
-
-    img = d->m_originalPixmap.toImage();
+    // The preview is small enough to be rotated right away
+    QImage img = d->m_originalPixmap.toImage();
     if (direction == Rotate90) {
         img = img.transformed(QTransform().rotate(90.0));
     } else if (direction == Rotate180) {
@@ -218,7 +389,7 @@ void KPixmapRegionSelectorWidget::rotate(RotateDirection direction)
 
     d->m_originalPixmap = QPixmap::fromImage(img);
 
-    d->m_linedPixmap = QPixmap();
+    d->previewChanged();
 
     if (d->m_forcedAspectRatio > 0 && d->m_forcedAspectRatio != 1) {
         resetSelection();
@@ -445,8 +616,15 @@ QRect KPixmapRegionSelectorWidget::unzoomedSelectedRegion() const
 
 QImage KPixmapRegionSelectorWidget::selectedImage() const
 {
-    QImage origImage = d->m_unzoomedPixmap.toImage();
-    return origImage.copy(unzoomedSelectedRegion());
+    const QRect region = unzoomedSelectedRegion();
+    if (d->m_quarterTurns == 0) {
+        return d->m_unzoomedPixmap.copy(region).toImage();
+    }
+
+    // Only rotate the selected part, taken from the unrotated pixmap
+    const QTransform toRotated = QImage::trueMatrix(d->rotation(), d->m_unzoomedPixmap.width(), d->m_unzoomedPixmap.height());
+    const QRect sourceRegion = toRotated.inverted().mapRect(QRectF(region)).toRect();
+    return d->m_unzoomedPixmap.copy(sourceRegion).toImage().transformed(d->rotation());
 }
 
 void KPixmapRegionSelectorWidget::setSelectionAspectRatio(int width, int height)
@@ -467,17 +645,24 @@ void KPixmapRegionSelectorWidget::setMaximumWidgetSize(int width, int height)
     if (d->m_selectedRegion == d->m_originalPixmap.rect()) {
         d->m_selectedRegion = QRect();
     }
+    const QSize rotatedSize = d->rotatedSize();
     d->m_originalPixmap = d->m_unzoomedPixmap;
 
     //   qCDebug(KWidgetsAddonsLog) << QString(" original Pixmap :") << d->m_originalPixmap.rect();
     //   qCDebug(KWidgetsAddonsLog) << QString(" unzoomed Pixmap : %1 x %2 ").arg(d->m_unzoomedPixmap.width()).arg(d->m_unzoomedPixmap.height());
 
-    if (!d->m_originalPixmap.isNull() && (d->m_originalPixmap.width() > d->m_maxWidth || d->m_originalPixmap.height() > d->m_maxHeight)) {
+    if (!d->m_originalPixmap.isNull() && (rotatedSize.width() > d->m_maxWidth || rotatedSize.height() > d->m_maxHeight)) {
         /* We have to resize the pixmap to get it complete on the screen */
+        /* Scale before rotating, so the rotation only touches the small image */
         QImage image = d->m_originalPixmap.toImage();
-        d->m_originalPixmap = QPixmap::fromImage(image.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        const QSize maxSize = d->m_quarterTurns % 2 ? QSize(height, width) : QSize(width, height);
+        image = image.scaled(maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        if (d->m_quarterTurns) {
+            image = image.transformed(d->rotation());
+        }
+        d->m_originalPixmap = QPixmap::fromImage(image);
         double oldZoomFactor = d->m_zoomFactor;
-        d->m_zoomFactor = d->m_originalPixmap.width() / (double)d->m_unzoomedPixmap.width();
+        d->m_zoomFactor = d->m_originalPixmap.width() / (double)rotatedSize.width();
 
         if (d->m_selectedRegion.isValid()) {
             d->m_selectedRegion = QRect((int)(d->m_selectedRegion.x() * d->m_zoomFactor / oldZoomFactor),
@@ -485,15 +670,17 @@ void KPixmapRegionSelectorWidget::setMaximumWidgetSize(int width, int height)
                                         (int)(d->m_selectedRegion.width() * d->m_zoomFactor / oldZoomFactor),
                                         (int)(d->m_selectedRegion.height() * d->m_zoomFactor / oldZoomFactor));
         }
+    } else if (d->m_quarterTurns) {
+        d->m_originalPixmap = QPixmap::fromImage(d->m_originalPixmap.toImage().transformed(d->rotation()));
     }
 
     if (!d->m_selectedRegion.isValid()) {
         d->m_selectedRegion = d->m_originalPixmap.rect();
     }
 
-    d->m_linedPixmap = QPixmap();
+    d->previewChanged();
     d->updatePixmap();
-    resize(d->m_label->width(), d->m_label->height());
+    resize(d->m_preview->width(), d->m_preview->height());
 }
 
 #include "moc_kpixmapregionselectorwidget.cpp"
@@ -120,6 +120,9 @@ public:
      * to rotate the selected region so that it doesn't change, as long as the
      * forced aspect ratio setting is respected, in other case, the selected region
      * is reset.
+     *
+     * Only the preview is rotated right away, the full resolution image is
+     * rotated in the background, see rotatedPixmapReady().
      */
     void rotate(RotateDirection direction);
 
@@ -139,6 +142,14 @@ Q_SIGNALS:
      */
     void pixmapRotated();
 
+    /*!
+     * Emitted when the full resolution image has been rotated in the background
+     * after rotate(), so that pixmap() returns without blocking.
+     *
+     * \since 6.30
+     */
+    void rotatedPixmapReady();
+
 protected:
     /*!
      * Creates a QMenu with the menu that appears when clicking with the right button on the label
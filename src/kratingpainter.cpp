@@ -7,6 +7,8 @@
 
 #include "kratingpainter.h"
 
+#include "kwidgetsaddonstiming_p.h"
+
 #include <QIcon>
 #include <QPainter>
 #include <QPixmap>
@@ -180,6 +182,7 @@ static void imageToSemiTransparent(QImage &img)
 
 void KRatingPainter::paint(QPainter *painter, const QRect &rect, int rating, int hoverRating) const
 {
+    const KWidgetsAddonsTiming::ScopedTimer timer("KRatingPainter", KWidgetsAddonsTiming::Paint);
     const qreal dpr = painter->device()->devicePixelRatio();
     rating = qMin(rating, d->maxRating);
     hoverRating = qMin(hoverRating, d->maxRating);
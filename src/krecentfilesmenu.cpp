@@ -3,13 +3,15 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include "krecentfilesmenu.h"
+#include "krecentfilesstore_p.h"
 
 #include <QGuiApplication>
 #include <QIcon>
 #include <QScreen>
-#include <QSettings>
 #include <QStandardPaths>
 
+#include <utility>
+
 class RecentFilesEntry
 {
 public:
@@ -60,14 +62,22 @@ public:
         return title;
     }
 
-    explicit RecentFilesEntry(const QUrl &_url, const QString &_displayName, KRecentFilesMenu *menu)
+    explicit RecentFilesEntry(const QUrl &_url, const QString &_displayName)
         : url(_url)
         , displayName(_displayName)
     {
-        action = new QAction(titleWithSensibleWidth(menu));
-        QObject::connect(action, &QAction::triggered, action, [this, menu]() {
-            Q_EMIT menu->urlTriggered(url);
-        });
+    }
+
+    // Created once and kept while the entry does not change, see KRecentFilesMenuPrivate::updateEntries()
+    QAction *ensureAction(KRecentFilesMenu *menu)
+    {
+        if (!action) {
+            action = new QAction(titleWithSensibleWidth(menu));
+            QObject::connect(action, &QAction::triggered, action, [this, menu]() {
+                Q_EMIT menu->urlTriggered(url);
+            });
+        }
+        return action;
     }
 
     ~RecentFilesEntry()
@@ -82,12 +92,14 @@ public:
     explicit KRecentFilesMenuPrivate(KRecentFilesMenu *q_ptr);
 
     std::vector<RecentFilesEntry *>::iterator findEntry(const QUrl &url);
-    void recentFilesChanged() const;
+    void updateEntries();
+    void recentFilesChanged();
 
     KRecentFilesMenu *const q;
     QString m_group = QStringLiteral("RecentFiles");
     std::vector<RecentFilesEntry *> m_entries;
-    QSettings *m_settings;
+    // Shared with the other menus using the same file
+    std::shared_ptr<KRecentFilesStore> m_store;
     size_t m_maximumItems = 10;
     QAction *m_noEntriesAction;
     QAction *m_clearAction;
@@ -105,7 +117,39 @@ std::vector<RecentFilesEntry *>::iterator KRecentFilesMenuPrivate::findEntry(con
     });
 }
 
-void KRecentFilesMenuPrivate::recentFilesChanged() const
+// Follows the entries of the store, keeping the entries (and their actions) which did not change
+void KRecentFilesMenuPrivate::updateEntries()
+{
+    const QList<KRecentFilesStore::Entry> stored = m_store->entries(m_group);
+    const size_t count = std::min<size_t>(stored.size(), m_maximumItems);
+
+    std::vector<RecentFilesEntry *> entries;
+    entries.reserve(count);
+    bool changed = count != m_entries.size();
+
+    for (size_t i = 0; i < count; ++i) {
+        const KRecentFilesStore::Entry &storedEntry = stored.at(i);
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [&storedEntry](const RecentFilesEntry *entry) {
+            return entry && entry->url == storedEntry.url && entry->displayName == storedEntry.displayName;
+        });
+        if (it != m_entries.end()) {
+            changed = changed || size_t(it - m_entries.begin()) != i;
+            entries.push_back(std::exchange(*it, nullptr));
+        } else {
+            changed = true;
+            entries.push_back(new RecentFilesEntry(storedEntry.url, storedEntry.displayName));
+        }
+    }
+
+    qDeleteAll(m_entries);
+    m_entries = std::move(entries);
+
+    if (changed) {
+        recentFilesChanged();
+    }
+}
+
+void KRecentFilesMenuPrivate::recentFilesChanged()
 {
     q->rebuildMenu();
     Q_EMIT q->recentFilesChanged();
@@ -118,13 +162,22 @@ KRecentFilesMenu::KRecentFilesMenu(const QString &title, QWidget *parent)
     setIcon(QIcon::fromTheme(QStringLiteral("document-open-recent")));
     const QString fileName =
         QStringLiteral("%1/%2_recentfiles").arg(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation), QCoreApplication::applicationName());
-    d->m_settings = new QSettings(fileName, QSettings::Format::IniFormat, this);
+    d->m_store = KRecentFilesStore::forFile(fileName);
+    d->m_store->setMaximumItems(this, d->m_group, qsizetype(d->m_maximumItems));
+    connect(d->m_store.get(), &KRecentFilesStore::changed, this, [this](const QString &group) {
+        if (group == d->m_group) {
+            d->updateEntries();
+        }
+    });
 
     d->m_noEntriesAction = new QAction(tr("No Entries"));
     d->m_noEntriesAction->setDisabled(true);
 
     d->m_clearAction = new QAction(QIcon::fromTheme(QStringLiteral("edit-clear-history")), tr("Clear List"));
+    connect(d->m_clearAction, &QAction::triggered, this, &KRecentFilesMenu::clearRecentFiles);
 
+    // Shows "No Entries" if there are none to read
+    rebuildMenu();
     readFromFile();
 }
 
@@ -135,6 +188,7 @@ KRecentFilesMenu::KRecentFilesMenu(QWidget *parent)
 
 KRecentFilesMenu::~KRecentFilesMenu()
 {
+    d->m_store->removeMenu(this);
     writeToFile();
     qDeleteAll(d->m_entries);
     delete d->m_clearAction;
@@ -143,66 +197,28 @@ KRecentFilesMenu::~KRecentFilesMenu()
 
 void KRecentFilesMenu::readFromFile()
 {
-    qDeleteAll(d->m_entries);
-    d->m_entries.clear();
-
-    d->m_settings->beginGroup(d->m_group);
-    const int size = d->m_settings->beginReadArray(QStringLiteral("files"));
-
-    d->m_entries.reserve(size);
-
-    for (int i = 0; i < size; ++i) {
-        d->m_settings->setArrayIndex(i);
-
-        const QUrl url = d->m_settings->value(QStringLiteral("url")).toUrl();
-        RecentFilesEntry *entry = new RecentFilesEntry(url, d->m_settings->value(QStringLiteral("displayName")).toString(), this);
-        d->m_entries.push_back(entry);
-    }
-
-    d->m_settings->endArray();
-    d->m_settings->endGroup();
-
-    d->recentFilesChanged();
+    d->m_store->reload(d->m_group);
+    d->updateEntries();
 }
 
 void KRecentFilesMenu::addUrl(const QUrl &url, const QString &name)
 {
-    if (d->m_entries.size() == d->m_maximumItems) {
-        delete d->m_entries.back();
-        d->m_entries.pop_back();
-    }
-
-    // If it's already there remove the old one and reinsert so it appears as new
-    auto it = d->findEntry(url);
-    if (it != d->m_entries.cend()) {
-        delete *it;
-        d->m_entries.erase(it);
-    }
-
     QString displayName = name;
 
     if (displayName.isEmpty()) {
         displayName = url.fileName();
     }
 
-    RecentFilesEntry *entry = new RecentFilesEntry(url, displayName, this);
-    d->m_entries.insert(d->m_entries.begin(), entry);
-
-    d->recentFilesChanged();
+    d->m_store->addUrl(d->m_group, {url, displayName});
 }
 
 void KRecentFilesMenu::removeUrl(const QUrl &url)
 {
-    auto it = d->findEntry(url);
-
-    if (it == d->m_entries.end()) {
+    if (d->findEntry(url) == d->m_entries.end()) {
         return;
     }
 
-    delete *it;
-    d->m_entries.erase(it);
-
-    d->recentFilesChanged();
+    d->m_store->removeUrl(d->m_group, url);
 }
 
 void KRecentFilesMenu::rebuildMenu()
@@ -214,34 +230,17 @@ void KRecentFilesMenu::rebuildMenu()
         return;
     }
 
-    for (const RecentFilesEntry *entry : d->m_entries) {
-        addAction(entry->action);
+    for (RecentFilesEntry *entry : d->m_entries) {
+        addAction(entry->ensureAction(this));
     }
 
     addSeparator();
     addAction(d->m_clearAction);
-
-    // reconnect d->m_clearAction, since it was disconnected in clear()
-    connect(d->m_clearAction, &QAction::triggered, this, &KRecentFilesMenu::clearRecentFiles);
 }
 
 void KRecentFilesMenu::writeToFile()
 {
-    d->m_settings->remove(QString());
-    d->m_settings->beginGroup(d->m_group);
-    d->m_settings->beginWriteArray(QStringLiteral("files"));
-
-    int index = 0;
-    for (const RecentFilesEntry *entry : d->m_entries) {
-        d->m_settings->setArrayIndex(index);
-        d->m_settings->setValue(QStringLiteral("url"), entry->url);
-        d->m_settings->setValue(QStringLiteral("displayName"), entry->displayName);
-        ++index;
-    }
-
-    d->m_settings->endArray();
-    d->m_settings->endGroup();
-    d->m_settings->sync();
+    d->m_store->writeNow();
 }
 
 QString KRecentFilesMenu::group() const
@@ -252,6 +251,7 @@ QString KRecentFilesMenu::group() const
 void KRecentFilesMenu::setGroup(const QString &group)
 {
     d->m_group = group;
+    d->m_store->setMaximumItems(this, d->m_group, qsizetype(d->m_maximumItems));
     readFromFile();
 }
 
@@ -263,14 +263,13 @@ int KRecentFilesMenu::maximumItems() const
 void KRecentFilesMenu::setMaximumItems(size_t maximumItems)
 {
     d->m_maximumItems = maximumItems;
+    d->m_store->setMaximumItems(this, d->m_group, qsizetype(maximumItems));
 
-    // Truncate if there are more entries than the new maximum
-    if (d->m_entries.size() > maximumItems) {
-        qDeleteAll(d->m_entries.begin() + maximumItems, d->m_entries.end());
-        d->m_entries.erase(d->m_entries.begin() + maximumItems, d->m_entries.end());
-
-        d->recentFilesChanged();
+    // Truncate if there are more entries than any menu of the group shows
+    if (d->m_store->entries(d->m_group).size() > d->m_store->maximumItems(d->m_group)) {
+        d->m_store->truncate(d->m_group);
     }
+    d->updateEntries();
 }
 
 QList<QUrl> KRecentFilesMenu::recentFiles() const
@@ -286,10 +285,7 @@ QList<QUrl> KRecentFilesMenu::recentFiles() const
 
 void KRecentFilesMenu::clearRecentFiles()
 {
-    qDeleteAll(d->m_entries);
-    d->m_entries.clear();
-
-    d->recentFilesChanged();
+    d->m_store->clear(d->m_group);
 }
 
 #include "moc_krecentfilesmenu.cpp"
@@ -20,6 +20,13 @@ class KRecentFilesMenuPrivate;
  *
  * \brief A menu that offers a set of recent files.
  *
+ * The actions of the menu follow the list of recent files as it changes,
+ * so actions() is up to date before the menu is shown.
+ *
+ * Changes to the list are written to the file in the background, after a
+ * short delay, so that adding several files is a single write. Pending
+ * changes are written before the menu is destroyed.
+ *
  * \since 5.74
  */
 class KWIDGETSADDONS_EXPORT KRecentFilesMenu : public QMenu
@@ -73,7 +80,8 @@ public:
      * The maximum number of files this menu can hold.
      *
      * When the maximum url count is reached and a new URL is added the
-     * oldest will be replaced.
+     * oldest will be replaced. Menus of the same application and group
+     * share their files, which are kept up to the largest maximum of them.
      *
      * By default maximum 10 URLs are shown.
      */
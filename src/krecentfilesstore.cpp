@@ -0,0 +1,392 @@
+// This file is part of the KDE libraries
+// SPDX-FileCopyrightText: 2026 KDE Developers
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "krecentfilesstore_p.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QFutureInterface>
+#include <QGlobalStatic>
+#include <QLockFile>
+#include <QRunnable>
+#include <QSettings>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+// Changes are written after this delay, so that a burst of added files is one write
+static constexpr int WRITE_DELAY_MS = 500;
+
+// The files of all stores are synced by one thread, so the writes reach the disk in order
+class RecentFilesWriter : public QThreadPool
+{
+public:
+    RecentFilesWriter()
+    {
+        setMaxThreadCount(1);
+    }
+};
+
+Q_GLOBAL_STATIC(RecentFilesWriter, s_recentFilesWriter)
+
+using StoreRegistry = QHash<QString, std::weak_ptr<KRecentFilesStore>>;
+Q_GLOBAL_STATIC(StoreRegistry, s_stores)
+
+using Entries = QHash<QString, QList<KRecentFilesStore::Entry>>;
+
+static QList<KRecentFilesStore::Entry> readGroup(QSettings &settings, const QString &group)
+{
+    QList<KRecentFilesStore::Entry> entries;
+
+    settings.beginGroup(group);
+    const int size = settings.beginReadArray(QStringLiteral("files"));
+    entries.reserve(size);
+
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+        entries.append({settings.value(QStringLiteral("url")).toUrl(), settings.value(QStringLiteral("displayName")).toString()});
+    }
+
+    settings.endArray();
+    settings.endGroup();
+
+    return entries;
+}
+
+static void writeGroup(QSettings &settings, const QString &group, const QList<KRecentFilesStore::Entry> &entries)
+{
+    settings.beginGroup(group);
+    settings.remove(QString());
+    settings.beginWriteArray(QStringLiteral("files"));
+
+    int index = 0;
+    for (const KRecentFilesStore::Entry &entry : entries) {
+        settings.setArrayIndex(index);
+        settings.setValue(QStringLiteral("url"), entry.url);
+        settings.setValue(QStringLiteral("displayName"), entry.displayName);
+        ++index;
+    }
+
+    settings.endArray();
+    settings.endGroup();
+}
+
+// Reads the groups from the file, and writes the changes on top of what was read
+class RunSync : public QFutureInterface<Entries>, public QRunnable
+{
+public:
+    RunSync(const QString &fileName, const QStringList &groups, const QHash<QString, QList<KRecentFilesStore::Change>> &changes)
+        : m_fileName(fileName)
+        , m_groups(groups)
+        , m_changes(changes)
+    {
+    }
+
+    QFuture<Entries> start()
+    {
+        setRunnable(this);
+        reportStarted();
+        QFuture<Entries> f = this->future();
+        s_recentFilesWriter->start(this);
+        return f;
+    }
+
+    void run() override
+    {
+        // Keep other processes from writing between our read and write
+        QLockFile lockFile(m_fileName + QLatin1String(".lock"));
+        if (!m_changes.isEmpty()) {
+            QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+            lockFile.lock();
+        }
+
+        QSettings settings(m_fileName, QSettings::Format::IniFormat);
+        // Pick up changes of other processes
+        settings.sync();
+
+        Entries result;
+        for (const QString &group : std::as_const(m_groups)) {
+            QList<KRecentFilesStore::Entry> entries = readGroup(settings, group);
+            auto it = m_changes.constFind(group);
+            if (it != m_changes.cend()) {
+                entries = KRecentFilesStore::applyChanges(entries, *it);
+                writeGroup(settings, group, entries);
+            }
+            result.insert(group, entries);
+        }
+
+        // QSettings::sync() replaces the file atomically, through QSaveFile
+        settings.sync();
+
+        reportResult(result);
+        reportFinished(nullptr);
+    }
+
+private:
+    const QString m_fileName;
+    const QStringList m_groups;
+    const QHash<QString, QList<KRecentFilesStore::Change>> m_changes;
+};
+
+KRecentFilesStore::KRecentFilesStore(const QString &fileName)
+    : m_fileName(fileName)
+    , m_writeTimer(new QTimer(this))
+    , m_fileWatcher(new QFileSystemWatcher(this))
+    , m_syncWatcher(new QFutureWatcher<Entries>(this))
+{
+    m_writeTimer->setSingleShot(true);
+    m_writeTimer->setInterval(WRITE_DELAY_MS);
+    connect(m_writeTimer, &QTimer::timeout, this, &KRecentFilesStore::write);
+
+    connect(m_syncWatcher, &QFutureWatcher<Entries>::finished, this, &KRecentFilesStore::syncFinished);
+
+    const auto fileChanged = [this]() {
+        // Replacing the file ends the watch, and the file may have been created
+        updateWatchedPaths();
+        startSync();
+    };
+    connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, fileChanged);
+    connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged, this, fileChanged);
+    updateWatchedPaths();
+}
+
+KRecentFilesStore::~KRecentFilesStore()
+{
+    QHash<QString, QList<Change>> changes;
+    for (auto it = m_groups.cbegin(); it != m_groups.cend(); ++it) {
+        if (!it->pending.isEmpty()) {
+            changes.insert(it.key(), it->pending);
+        }
+    }
+
+    // Nobody waits for the result, the runnable is deleted by the pool once done
+    if (!changes.isEmpty()) {
+        (new RunSync(m_fileName, changes.keys(), changes))->start();
+    }
+}
+
+std::shared_ptr<KRecentFilesStore> KRecentFilesStore::forFile(const QString &fileName)
+{
+    std::shared_ptr<KRecentFilesStore> store = s_stores->value(fileName).lock();
+    if (!store) {
+        store.reset(new KRecentFilesStore(fileName));
+        s_stores->insert(fileName, store);
+    }
+    return store;
+}
+
+QList<KRecentFilesStore::Entry> KRecentFilesStore::entries(const QString &group)
+{
+    return this->group(group).entries;
+}
+
+void KRecentFilesStore::reload(const QString &name)
+{
+    auto it = m_groups.find(name);
+    if (it == m_groups.end()) {
+        // Not read yet, group() reads it
+        group(name);
+        return;
+    }
+
+    QSettings settings(m_fileName, QSettings::Format::IniFormat);
+    it->stored = readGroup(settings, name);
+    updateEntries(name, *it);
+}
+
+void KRecentFilesStore::setMaximumItems(const QObject *menu, const QString &group, qsizetype maximumItems)
+{
+    m_menuLimits.insert(menu, {group, maximumItems});
+}
+
+void KRecentFilesStore::removeMenu(const QObject *menu)
+{
+    m_menuLimits.remove(menu);
+}
+
+qsizetype KRecentFilesStore::maximumItems(const QString &group) const
+{
+    qsizetype maximumItems = -1;
+    for (const auto &[menuGroup, menuMaximumItems] : std::as_const(m_menuLimits)) {
+        if (menuGroup == group) {
+            maximumItems = std::max(maximumItems, menuMaximumItems);
+        }
+    }
+    return maximumItems >= 0 ? maximumItems : std::numeric_limits<qsizetype>::max();
+}
+
+void KRecentFilesStore::addUrl(const QString &group, const Entry &entry)
+{
+    change(group, {Change::Add, entry, maximumItems(group)});
+}
+
+void KRecentFilesStore::removeUrl(const QString &group, const QUrl &url)
+{
+    change(group, {Change::Remove, {url, QString()}});
+}
+
+void KRecentFilesStore::clear(const QString &group)
+{
+    change(group, {Change::Clear, {}});
+}
+
+void KRecentFilesStore::truncate(const QString &group)
+{
+    change(group, {Change::Truncate, {}, maximumItems(group)});
+}
+
+void KRecentFilesStore::flush()
+{
+    if (m_writeTimer->isActive()) {
+        write();
+    }
+}
+
+void KRecentFilesStore::writeNow()
+{
+    flush();
+    // A write requested while another sync runs is started once that one finished
+    while (m_syncWatcher->isRunning() || m_syncRequested) {
+        m_syncWatcher->waitForFinished();
+        // Delivers finished(), syncFinished() starts the requested sync
+        QCoreApplication::sendPostedEvents(m_syncWatcher);
+    }
+}
+
+void KRecentFilesStore::write()
+{
+    m_writeTimer->stop();
+    m_writeRequested = true;
+    startSync();
+}
+
+QList<KRecentFilesStore::Entry> KRecentFilesStore::applyChanges(QList<Entry> entries, const QList<Change> &changes)
+{
+    const auto removeUrl = [&entries](const QUrl &url) {
+        entries.removeIf([&url](const Entry &entry) {
+            return entry.url == url;
+        });
+    };
+
+    for (const Change &change : changes) {
+        switch (change.type) {
+        case Change::Add:
+            // If it's already there remove the old one and reinsert so it appears as new
+            removeUrl(change.entry.url);
+            entries.prepend(change.entry);
+            if (entries.size() > change.maximumItems) {
+                entries.resize(change.maximumItems);
+            }
+            break;
+        case Change::Remove:
+            removeUrl(change.entry.url);
+            break;
+        case Change::Clear:
+            entries.clear();
+            break;
+        case Change::Truncate:
+            if (entries.size() > change.maximumItems) {
+                entries.resize(change.maximumItems);
+            }
+            break;
+        }
+    }
+
+    return entries;
+}
+
+KRecentFilesStore::Group &KRecentFilesStore::group(const QString &name)
+{
+    auto it = m_groups.find(name);
+    if (it == m_groups.end()) {
+        // Read once when a menu first uses the group, later syncs keep it up to date
+        QSettings settings(m_fileName, QSettings::Format::IniFormat);
+        const QList<Entry> entries = readGroup(settings, name);
+        it = m_groups.insert(name, {entries, {}, {}, entries});
+    }
+    return *it;
+}
+
+void KRecentFilesStore::change(const QString &name, const Change &change)
+{
+    Group &group = this->group(name);
+    group.pending.append(change);
+    updateEntries(name, group);
+    m_writeTimer->start();
+}
+
+void KRecentFilesStore::updateEntries(const QString &name, Group &group)
+{
+    QList<Entry> entries = applyChanges(applyChanges(group.stored, group.writing), group.pending);
+    if (entries != group.entries) {
+        group.entries = std::move(entries);
+        Q_EMIT changed(name);
+    }
+}
+
+void KRecentFilesStore::startSync()
+{
+    if (m_syncWatcher->isRunning()) {
+        m_syncRequested = true;
+        return;
+    }
+
+    QHash<QString, QList<Change>> changes;
+    if (m_writeRequested) {
+        m_writeRequested = false;
+        for (auto it = m_groups.begin(); it != m_groups.end(); ++it) {
+            if (!it->pending.isEmpty()) {
+                it->writing = std::exchange(it->pending, {});
+                changes.insert(it.key(), it->writing);
+            }
+        }
+    }
+
+    m_syncWatcher->setFuture((new RunSync(m_fileName, m_groups.keys(), changes))->start());
+}
+
+void KRecentFilesStore::syncFinished()
+{
+    const Entries result = m_syncWatcher->result();
+    for (auto it = result.cbegin(); it != result.cend(); ++it) {
+        auto groupIt = m_groups.find(it.key());
+        if (groupIt != m_groups.end()) {
+            groupIt->stored = it.value();
+            groupIt->writing.clear();
+            updateEntries(it.key(), *groupIt);
+        }
+    }
+
+    // The file may have been created by the write
+    updateWatchedPaths();
+
+    if (m_syncRequested) {
+        m_syncRequested = false;
+        startSync();
+    }
+}
+
+void KRecentFilesStore::updateWatchedPaths()
+{
+    // Watch the directory until the file exists, to notice it being created
+    const QFileInfo fileInfo(m_fileName);
+    const QString directory = fileInfo.absolutePath();
+    if (fileInfo.exists()) {
+        if (!m_fileWatcher->files().contains(m_fileName)) {
+            m_fileWatcher->addPath(m_fileName);
+        }
+        if (m_fileWatcher->directories().contains(directory)) {
+            m_fileWatcher->removePath(directory);
+        }
+    } else if (!m_fileWatcher->directories().contains(directory) && QFileInfo::exists(directory)) {
+        m_fileWatcher->addPath(directory);
+    }
+}
+
+#include "moc_krecentfilesstore_p.cpp"
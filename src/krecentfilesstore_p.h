@@ -0,0 +1,144 @@
+// This file is part of the KDE libraries
+// SPDX-FileCopyrightText: 2026 KDE Developers
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef KRECENTFILESSTORE_P_H
+#define KRECENTFILESSTORE_P_H
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+#include <memory>
+#include <utility>
+
+class QFileSystemWatcher;
+class QTimer;
+
+/*!
+ * \internal
+ *
+ * The recent files of one file, shared by all KRecentFilesMenu instances of
+ * the process using it, and kept in sync with other processes.
+ *
+ * Changes are applied in memory at once and notified to the menus with
+ * changed(), then written in the background after a short delay. A write
+ * re-reads the file under a lock file and replays the changes on top of it,
+ * so concurrent writers merge instead of overwriting each other. The file is
+ * watched, changes of other processes are read in the background as well.
+ */
+class KRecentFilesStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        QUrl url;
+        QString displayName;
+
+        bool operator==(const Entry &other) const
+        {
+            return url == other.url && displayName == other.displayName;
+        }
+    };
+
+    struct Change {
+        enum Type {
+            Add,
+            Remove,
+            Clear,
+            Truncate,
+        };
+
+        Type type;
+        Entry entry; // for Add and Remove
+        qsizetype maximumItems = 0; // for Add and Truncate
+    };
+
+    ~KRecentFilesStore() override;
+
+    /*!
+     * Returns the store of \a fileName, created if no menu uses it yet.
+     */
+    static std::shared_ptr<KRecentFilesStore> forFile(const QString &fileName);
+
+    /*!
+     * Returns the entries of \a group, most recent first.
+     */
+    QList<Entry> entries(const QString &group);
+
+    /*!
+     * Re-reads \a group from the file now, instead of waiting for the file
+     * watcher to notice changes of other processes.
+     */
+    void reload(const QString &group);
+
+    /*!
+     * Sets how many entries of \a group \a menu shows. A group keeps as many
+     * entries as the largest maximum of the menus using it, so that a menu
+     * showing few entries does not drop the ones of the others.
+     */
+    void setMaximumItems(const QObject *menu, const QString &group, qsizetype maximumItems);
+    void removeMenu(const QObject *menu);
+
+    /*!
+     * Returns the largest maximum of the menus using \a group, or no limit
+     * if no menu uses it.
+     */
+    qsizetype maximumItems(const QString &group) const;
+
+    void addUrl(const QString &group, const Entry &entry);
+    void removeUrl(const QString &group, const QUrl &url);
+    void clear(const QString &group);
+    void truncate(const QString &group);
+
+    /*!
+     * Starts writing pending changes now instead of after the delay.
+     */
+    void flush();
+
+    /*!
+     * Writes pending changes now, and returns once they are in the file.
+     */
+    void writeNow();
+
+    static QList<Entry> applyChanges(QList<Entry> entries, const QList<Change> &changes);
+
+Q_SIGNALS:
+    void changed(const QString &group);
+
+private:
+    explicit KRecentFilesStore(const QString &fileName);
+
+    struct Group {
+        QList<Entry> stored; // as last read from or written to the file
+        QList<Change> writing; // being written
+        QList<Change> pending; // waiting for the next write
+        QList<Entry> entries; // stored, with writing and pending applied
+    };
+
+    Group &group(const QString &name);
+    void change(const QString &name, const Change &change);
+    void write();
+    void updateEntries(const QString &name, Group &group);
+    void startSync();
+    void syncFinished();
+    void updateWatchedPaths();
+
+    const QString m_fileName;
+    QHash<QString, Group> m_groups;
+    // The group and maximum number of entries of each menu
+    QHash<const QObject *, std::pair<QString, qsizetype>> m_menuLimits;
+    QTimer *m_writeTimer;
+    QFileSystemWatcher *m_fileWatcher;
+    QFutureWatcher<QHash<QString, QList<Entry>>> *m_syncWatcher;
+    // Whether the next sync writes the pending changes, or only reads
+    bool m_writeRequested = false;
+    // Whether to sync again once the running sync finished
+    bool m_syncRequested = false;
+};
+
+#endif
@@ -8,9 +8,14 @@
 #include "kruler.h"
 
 #include <QFont>
+#include <QPixmap>
 #include <QPolygon>
 #include <QStylePainter>
 
+#include <cmath>
+#include <numeric>
+#include <tuple>
+
 #define INIT_VALUE 0
 #define INIT_MIN_VALUE 0
 #define INIT_MAX_VALUE 100
@@ -49,6 +54,8 @@
 #define BASE_MARK_X2 LINE_END
 #define BASE_MARK_X1 (BASE_MARK_X2 - BASE_MARK_LENGTH)
 
+#define MAX_TICK_TILE_LENGTH 2048 /* longest period of marks rendered into a tile */
+
 #define LABEL_SIZE 8
 #define END_LABEL_X 4
 #define END_LABEL_Y (END_LABEL_X + LABEL_SIZE - 2)
@@ -93,8 +100,108 @@ public:
     double ppm; /* pixel per mark */
 
     QString endlabel;
+
+    // Reused by paintEvent() to draw the marks with one drawLines() call
+    QList<QLine> tickLines;
+
+    // One period of all shown marks, tiled along the ruler
+    struct TickTileKey {
+        Qt::Orientation dir;
+        int period;
+        int thickness;
+        qreal devicePixelRatio;
+        QRgb color;
+
+        bool operator==(const TickTileKey &other) const
+        {
+            return std::tie(dir, period, thickness, devicePixelRatio, color)
+                == std::tie(other.dir, other.period, other.thickness, other.devicePixelRatio, other.color);
+        }
+    };
+    TickTileKey tickTileKey = {};
+    QPixmap tickTile;
+
+    void appendTicks(double start, double end, int distance, int x1, int x2);
+    void appendAllTicks(double start, double end);
+    int tickPeriod() const;
+    const QPixmap &ensureTickTile(int period, int thickness, const QColor &color, qreal devicePixelRatio);
 };
 
+void KRulerPrivate::appendTicks(double start, double end, int distance, int x1, int x2)
+{
+    const double step = ppm * distance;
+    if (step <= 0) {
+        return;
+    }
+    for (double f = start; f < end; f += step) {
+        if (dir == Qt::Horizontal) {
+            tickLines.append(QLine((int)f, x1, (int)f, x2));
+        } else {
+            tickLines.append(QLine(x1, (int)f, x2, (int)f));
+        }
+    }
+}
+
+void KRulerPrivate::appendAllTicks(double start, double end)
+{
+    tickLines.clear();
+    if (showtm) {
+        appendTicks(start, end, tmDist, BASE_MARK_X1, BASE_MARK_X2);
+    }
+    if (showlm) {
+        appendTicks(start, end, lmDist, LITTLE_MARK_X1, LITTLE_MARK_X2);
+    }
+    if (showmm) {
+        appendTicks(start, end, mmDist, MIDDLE_MARK_X1, MIDDLE_MARK_X2);
+    }
+    if (showbm) {
+        appendTicks(start, end, bmDist, BIG_MARK_X1, BIG_MARK_X2);
+    }
+}
+
+// Returns the length in pixels after which the shown marks repeat, or 0 if
+// they do not repeat at whole pixels and so cannot be tiled.
+int KRulerPrivate::tickPeriod() const
+{
+    const std::pair<bool, int> marks[] = {{showtm, tmDist}, {showlm, lmDist}, {showmm, mmDist}, {showbm, bmDist}};
+    int period = 0;
+    for (const auto &[shown, distance] : marks) {
+        if (!shown) {
+            continue;
+        }
+        const double step = ppm * distance;
+        const double roundedStep = std::round(step);
+        if (roundedStep < 1 || std::abs(step - roundedStep) > 1e-9) {
+            return 0;
+        }
+        period = period ? std::lcm(period, int(roundedStep)) : int(roundedStep);
+        if (period > MAX_TICK_TILE_LENGTH) {
+            return 0;
+        }
+    }
+    return period;
+}
+
+const QPixmap &KRulerPrivate::ensureTickTile(int period, int thickness, const QColor &color, qreal devicePixelRatio)
+{
+    const TickTileKey key = {dir, period, thickness, devicePixelRatio, color.rgba()};
+    if (!tickTile.isNull() && key == tickTileKey) {
+        return tickTile;
+    }
+
+    tickTileKey = key;
+    const QSize size = dir == Qt::Horizontal ? QSize(period, thickness) : QSize(thickness, period);
+    tickTile = QPixmap(size * devicePixelRatio);
+    tickTile.setDevicePixelRatio(devicePixelRatio);
+    tickTile.fill(Qt::transparent);
+
+    appendAllTicks(0, period);
+    QPainter painter(&tickTile);
+    painter.setPen(color);
+    painter.drawLines(tickLines);
+    return tickTile;
+}
+
 KRuler::KRuler(QWidget *parent)
     : QAbstractSlider(parent)
     , d(new KRulerPrivate)
@@ -551,8 +658,6 @@ void KRuler::paintEvent(QPaintEvent * /*e*/)
         //    pixelpm = (int)ppm;
         //    left  = clip.left(),
         //    right = clip.right();
-        double f;
-        double fend;
         double offsetmin = (double)(minval - d->offset);
         double offsetmax = (double)(maxval - d->offset);
         double fontOffset = (((double)minval) > offsetmin) ? (double)minval : offsetmin;
@@ -586,49 +691,24 @@ void KRuler::paintEvent(QPaintEvent * /*e*/)
             p.resetTransform();
         }
 
-        // draw the tiny marks
-        if (d->showtm) {
-            fend = d->ppm * d->tmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, BASE_MARK_X1, (int)f, BASE_MARK_X2);
-                } else {
-                    p.drawLine(BASE_MARK_X1, (int)f, BASE_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showlm) {
-            // draw the little marks
-            fend = d->ppm * d->lmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, LITTLE_MARK_X1, (int)f, LITTLE_MARK_X2);
-                } else {
-                    p.drawLine(LITTLE_MARK_X1, (int)f, LITTLE_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showmm) {
-            // draw medium marks
-            fend = d->ppm * d->mmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
+        // draw the tiny, little, medium and big marks
+        const int period = d->tickPeriod();
+        if (period > 0) {
+            // the marks repeat at whole pixels, so scrolling only shifts a cached tile
+            const int thickness = d->dir == Qt::Horizontal ? height() : width();
+            const QPixmap &tile = d->ensureTickTile(period, thickness, p.pen().color(), devicePixelRatioF());
+            const int start = (int)offsetmin;
+            const int length = (int)std::ceil(offsetmax) - start;
+            if (length > 0) {
                 if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, MIDDLE_MARK_X1, (int)f, MIDDLE_MARK_X2);
+                    p.drawTiledPixmap(QRect(start, 0, length, thickness), tile);
                 } else {
-                    p.drawLine(MIDDLE_MARK_X1, (int)f, MIDDLE_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showbm) {
-            // draw big marks
-            fend = d->ppm * d->bmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, BIG_MARK_X1, (int)f, BIG_MARK_X2);
-                } else {
-                    p.drawLine(BIG_MARK_X1, (int)f, BIG_MARK_X2, (int)f);
+                    p.drawTiledPixmap(QRect(0, start, thickness, length), tile);
                 }
             }
+        } else {
+            d->appendAllTicks(offsetmin, offsetmax);
+            p.drawLines(d->tickLines);
         }
         if (d->showem) {
             // draw end marks
@@ -23,11 +23,13 @@
 
 #include "loggingcategory.h"
 
-#include <QActionEvent>
+#include <QAbstractListModel>
+#include <QCompleter>
 #include <QEvent>
+#include <QLineEdit>
 #include <QMenu>
-#include <QStandardItem>
 #include <QToolBar>
+#include <QVarLengthArray>
 
 // QAction::setText("Hi") and then KPopupAccelManager exec'ing, causes
 // QAction::text() to return "&Hi" :(  Comboboxes don't have accels and
@@ -49,6 +51,90 @@ static QString DropAmpersands(const QString &text)
     return label;
 }
 
+// The items of the combo boxes of a KSelectAction, one row per selectable action
+// in the order of the action group. Shared by all combo boxes, so adding or
+// removing an action is one model notification instead of an update per widget.
+class KSelectActionModel : public QAbstractListModel
+{
+public:
+    using QAbstractListModel::QAbstractListModel;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_actions.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+            return QVariant();
+        }
+
+        QAction *action = m_actions.at(index.row());
+        switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return ::DropAmpersands(action->text());
+        case Qt::DecorationRole:
+            return action->icon();
+        case Qt::UserRole:
+            return QVariant::fromValue(action);
+        default:
+            return QVariant();
+        }
+    }
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+            return Qt::NoItemFlags;
+        }
+        return m_actions.at(index.row())->isEnabled() ? Qt::ItemIsEnabled | Qt::ItemIsSelectable : Qt::NoItemFlags;
+    }
+
+    int row(QAction *action) const
+    {
+        return m_actions.indexOf(action);
+    }
+
+    void appendAction(QAction *action)
+    {
+        beginInsertRows(QModelIndex(), m_actions.size(), m_actions.size());
+        m_actions.append(action);
+        endInsertRows();
+    }
+
+    void removeAction(QAction *action)
+    {
+        const int row = m_actions.indexOf(action);
+        if (row < 0) {
+            return;
+        }
+        beginRemoveRows(QModelIndex(), row, row);
+        m_actions.removeAt(row);
+        endRemoveRows();
+    }
+
+    void actionChanged(QAction *action)
+    {
+        const int row = m_actions.indexOf(action);
+        if (row >= 0) {
+            const QModelIndex changed = index(row);
+            Q_EMIT dataChanged(changed, changed);
+        }
+    }
+
+    void reset(const QList<QAction *> &actions)
+    {
+        beginResetModel();
+        m_actions = actions;
+        endResetModel();
+    }
+
+private:
+    QList<QAction *> m_actions;
+};
+
 KSelectAction::KSelectAction(QObject *parent)
     : KSelectAction(*new KSelectActionPrivate(this), parent)
 {
@@ -86,6 +172,38 @@ void KSelectActionPrivate::init()
     QObject::connect(q_ptr, &QAction::toggled, q_ptr, &KSelectAction::slotToggled);
     q_ptr->setMenu(new QMenu());
     q_ptr->setEnabled(false);
+    m_model = new KSelectActionModel(q_ptr);
+}
+
+template<typename Change>
+void KSelectActionPrivate::changeModel(Change change)
+{
+    Q_Q(KSelectAction);
+    // Signals are blocked as the combo boxes may change their current index
+    // while following the model, which would trigger an action.
+    QVarLengthArray<bool, 4> blocked;
+    for (QComboBox *comboBox : std::as_const(m_comboBoxes)) {
+        blocked.append(comboBox->blockSignals(true));
+    }
+
+    change();
+
+    const int currentItem = q->currentItem();
+    for (int i = 0; i < m_comboBoxes.size(); ++i) {
+        m_comboBoxes[i]->setCurrentIndex(currentItem);
+        m_comboBoxes[i]->blockSignals(blocked[i]);
+    }
+}
+
+void KSelectActionPrivate::updateComboBoxesCurrentIndex(int index)
+{
+    for (QComboBox *comboBox : std::as_const(m_comboBoxes)) {
+        if (comboBox->currentIndex() != index) {
+            const bool blocked = comboBox->blockSignals(true);
+            comboBox->setCurrentIndex(index);
+            comboBox->blockSignals(blocked);
+        }
+    }
 }
 
 QActionGroup *KSelectAction::selectableActionGroup() const
@@ -122,7 +240,7 @@ bool KSelectAction::setCurrentAction(QAction *action)
 {
     // qCDebug(KWidgetsAddonsLog) << "KSelectAction::setCurrentAction(" << action << ")";
     if (action) {
-        if (actions().contains(action)) {
+        if (action->actionGroup() == selectableActionGroup()) {
             if (action->isVisible() && action->isEnabled() && action->isCheckable()) {
                 action->setChecked(true);
                 if (isCheckable()) {
@@ -162,29 +280,101 @@ QAction *KSelectAction::action(int index) const
 
 QAction *KSelectAction::action(const QString &text, Qt::CaseSensitivity cs) const
 {
-    QString compare;
+    Q_D(const KSelectAction);
+    d->ensureTextIndex();
     if (cs == Qt::CaseSensitive) {
-        compare = text;
+        return d->m_actionsByText.value(text);
+    }
+    return d->m_actionsByFoldedText.value(text.toCaseFolded());
+}
+
+void KSelectActionPrivate::indexActionText(QAction *action) const
+{
+    const QString text = ::DropAmpersands(action->text());
+    m_indexedTexts.insert(action, text);
+    if (!m_actionsByText.contains(text)) {
+        m_actionsByText.insert(text, action);
+    }
+    const QString foldedText = text.toCaseFolded();
+    if (!m_actionsByFoldedText.contains(foldedText)) {
+        m_actionsByFoldedText.insert(foldedText, action);
+    }
+}
+
+void KSelectActionPrivate::ensureTextIndex() const
+{
+    if (m_textIndexValid) {
+        return;
+    }
+
+    m_actionsByText.clear();
+    m_actionsByFoldedText.clear();
+    m_indexedTexts.clear();
+    const auto actions = m_actionGroup->actions();
+    for (QAction *action : actions) {
+        indexActionText(action);
+    }
+    m_textIndexValid = true;
+}
+
+void KSelectActionPrivate::actionInserted(QAction *action, bool appended)
+{
+    Q_Q(KSelectAction);
+    if (!m_bulkUpdate) {
+        changeModel([this, action]() {
+            m_model->appendAction(action);
+        });
+    }
+
+    QObject::connect(action, &QAction::changed, q, [this, action]() {
+        actionChanged(action);
+    });
+    // QActionGroup drops deleted actions by itself, the model has to as well.
+    // Only the pointer value is used, the action is already destroyed.
+    QObject::connect(action, &QObject::destroyed, q, [this, action]() {
+        m_textIndexValid = false;
+        changeModel([this, action]() {
+            m_model->removeAction(action);
+        });
+    });
+
+    if (!m_textIndexValid) {
+        return;
+    }
+    if (appended) {
+        // Comes after all others, so it cannot shadow an indexed action
+        indexActionText(action);
     } else {
-        compare = text.toLower();
+        m_textIndexValid = false;
     }
+}
 
-    const auto selectableActions = selectableActionGroup()->actions();
-    for (QAction *action : selectableActions) {
-        const QString text = ::DropAmpersands(action->text());
-        if (cs == Qt::CaseSensitive) {
-            if (text == compare) {
-                return action;
-            }
+void KSelectActionPrivate::actionRemoved(QAction *action)
+{
+    Q_Q(KSelectAction);
+    QObject::disconnect(action, &QAction::changed, q, nullptr);
+    QObject::disconnect(action, &QObject::destroyed, q, nullptr);
+    m_textIndexValid = false;
 
-        } else if (cs == Qt::CaseInsensitive) {
-            if (text.toLower() == compare) {
-                return action;
-            }
-        }
+    if (!m_bulkUpdate) {
+        changeModel([this, action]() {
+            m_model->removeAction(action);
+        });
     }
+}
 
-    return nullptr;
+void KSelectActionPrivate::actionChanged(QAction *action)
+{
+    Q_Q(KSelectAction);
+    if (m_textIndexValid && m_indexedTexts.value(action) != ::DropAmpersands(action->text())) {
+        m_textIndexValid = false;
+    }
+
+    if (!m_bulkUpdate) {
+        m_model->actionChanged(action);
+        // The checked action may have changed
+        updateComboBoxesCurrentIndex(action->isChecked() ? m_model->row(action) : q->currentItem());
+    }
 }
 
 bool KSelectAction::setCurrentAction(const QString &text, Qt::CaseSensitivity cs)
@@ -265,6 +455,7 @@ QAction *KSelectAction::removeAction(QAction *action)
 
     // Removes the action from the group and sets its parent to null.
     d->m_actionGroup->removeAction(action);
+    d->actionRemoved(action);
 
     // Disable when no action is in the group
     bool hasActions = selectableActionGroup()->actions().isEmpty();
@@ -277,7 +468,6 @@ QAction *KSelectAction::removeAction(QAction *action)
 
     for (QComboBox *comboBox : std::as_const(d->m_comboBoxes)) {
         comboBox->setEnabled(!hasActions);
-        comboBox->removeAction(action);
     }
 
     menu()->removeAction(action);
@@ -288,7 +478,12 @@ QAction *KSelectAction::removeAction(QAction *action)
 void KSelectAction::insertAction(QAction *before, QAction *action)
 {
     Q_D(KSelectAction);
-    action->setActionGroup(selectableActionGroup());
+    // Inserting an action again only moves it in the menus, like QWidget::insertAction().
+    // The action group keeps its order, and so does the model.
+    if (action->actionGroup() != selectableActionGroup()) {
+        action->setActionGroup(selectableActionGroup());
+        d->actionInserted(action, !before);
+    }
 
     // Re-Enable when an action is added
     setEnabled(true);
@@ -301,7 +496,6 @@ void KSelectAction::insertAction(QAction *before, QAction *action)
 
     for (QComboBox *comboBox : std::as_const(d->m_comboBoxes)) {
         comboBox->setEnabled(true);
-        comboBox->insertAction(before, action);
     }
 
     menu()->insertAction(before, action);
@@ -355,6 +549,9 @@ void KSelectAction::setItems(const QStringList &lst)
     Q_D(KSelectAction);
     // qCDebug(KWidgetsAddonsLog) << "KSelectAction::setItems(" << lst << ")";
 
+    // Reset the combo box model once at the end, instead of updating it per action
+    d->m_bulkUpdate = true;
+
     clear();
 
     for (const QString &string : lst) {
@@ -367,6 +564,11 @@ void KSelectAction::setItems(const QStringList &lst)
         }
     }
 
+    d->m_bulkUpdate = false;
+    d->changeModel([d]() {
+        d->m_model->reset(d->m_actionGroup->actions());
+    });
+
     // Disable if empty and not editable
     setEnabled(lst.count() > 0 || d->m_edit);
 }
@@ -382,6 +584,9 @@ void KSelectAction::clear()
     Q_D(KSelectAction);
     // qCDebug(KWidgetsAddonsLog) << "KSelectAction::clear()";
 
+    const bool bulkUpdate = d->m_bulkUpdate;
+    d->m_bulkUpdate = true;
+
     // we need to delete the actions later since we may get a call to clear()
     // from a method called due to a triggered(...) signal
     const QList<QAction *> actions = d->m_actionGroup->actions();
@@ -395,6 +600,13 @@ void KSelectAction::clear()
 
         actions[i]->deleteLater();
     }
+
+    d->m_bulkUpdate = bulkUpdate;
+    if (!bulkUpdate) {
+        d->changeModel([d]() {
+            d->m_model->reset({});
+        });
+    }
 }
 
 void KSelectAction::removeAllActions()
@@ -411,7 +623,10 @@ void KSelectAction::setEditable(bool edit)
     d->m_edit = edit;
 
     for (QComboBox *comboBox : std::as_const(d->m_comboBoxes)) {
-        comboBox->setEditable(edit);
+        if (comboBox->isEditable() != edit) {
+            comboBox->setEditable(edit);
+            d->connectComboBoxLineEdit(comboBox);
+        }
     }
 
     Q_EMIT changed();
@@ -465,27 +680,11 @@ void KSelectActionPrivate::comboBoxCurrentIndexChanged(int index)
     Q_Q(KSelectAction);
     // qCDebug(KWidgetsAddonsLog) << "KSelectActionPrivate::comboBoxCurrentIndexChanged(" << index << ")";
 
-    QComboBox *triggeringCombo = qobject_cast<QComboBox *>(q->sender());
-
     QAction *a = q->action(index);
     // qCDebug(KWidgetsAddonsLog) << "\ta=" << a;
     if (a) {
         // qCDebug(KWidgetsAddonsLog) << "\t\tsetting as current action";
         a->trigger();
-
-    } else if (q->isEditable() && triggeringCombo && triggeringCombo->count() > 0 && index == triggeringCombo->count() - 1) {
-        // User must have added a new item by typing and pressing enter.
-        const QString newItemText = triggeringCombo->currentText();
-        // qCDebug(KWidgetsAddonsLog) << "\t\tuser typed new item '" << newItemText << "'";
-
-        // Only 1 combobox contains this and it's not a proper action.
-        bool blocked = triggeringCombo->blockSignals(true);
-        triggeringCombo->removeItem(index);
-        triggeringCombo->blockSignals(blocked);
-
-        QAction *newAction = q->addAction(newItemText);
-
-        newAction->trigger();
     } else {
         if (q->selectableActionGroup()->checkedAction()) {
             q->selectableActionGroup()->checkedAction()->setChecked(false);
@@ -493,6 +692,33 @@ void KSelectActionPrivate::comboBoxCurrentIndexChanged(int index)
     }
 }
 
+void KSelectActionPrivate::comboBoxReturnPressed(QComboBox *comboBox)
+{
+    Q_Q(KSelectAction);
+    // The combo boxes do not insert typed in items into the shared model,
+    // items already there have been selected by QComboBox itself.
+    // QComboBox matches the typed text as its completer does, case insensitively by default
+    const QString newItemText = comboBox->currentText();
+    const Qt::CaseSensitivity cs = comboBox->completer() ? comboBox->completer()->caseSensitivity() : Qt::CaseInsensitive;
+    if (newItemText.isEmpty() || q->action(newItemText, cs)) {
+        return;
+    }
+
+    // qCDebug(KWidgetsAddonsLog) << "\t\tuser typed new item '" << newItemText << "'";
+    QAction *newAction = q->addAction(newItemText);
+    newAction->trigger();
+}
+
+void KSelectActionPrivate::connectComboBoxLineEdit(QComboBox *comboBox)
+{
+    Q_Q(KSelectAction);
+    if (QLineEdit *lineEdit = comboBox->lineEdit()) {
+        QObject::connect(lineEdit, &QLineEdit::returnPressed, q, [this, comboBox]() {
+            comboBoxReturnPressed(comboBox);
+        });
+    }
+}
+
 // TODO: DropAmpersands() certainly makes sure this doesn't work.  But I don't
 // think it did anyway esp. in the presence KCheckAccelerator - Clarence.
 void KSelectAction::setMenuAccelsEnabled(bool b)
@@ -555,20 +781,23 @@ QWidget *KSelectAction::createWidget(QWidget *parent)
         }
 
         comboBox->setEditable(isEditable());
+        // Typed in items become actions, see comboBoxReturnPressed()
+        comboBox->setInsertPolicy(QComboBox::NoInsert);
         comboBox->setToolTip(toolTip());
         comboBox->setWhatsThis(whatsThis());
         comboBox->setStatusTip(statusTip());
         comboBox->setPlaceholderText(text());
 
-        const auto selectableActions = selectableActionGroup()->actions();
-        for (QAction *action : selectableActions) {
-            comboBox->addAction(action);
-        }
+        // Do this before connecting the signals so that nothing will fire.
+        comboBox->setModel(d->m_model);
+        comboBox->setCurrentIndex(currentItem());
 
-        if (selectableActions.isEmpty()) {
+        if (d->m_model->rowCount() == 0) {
             comboBox->setEnabled(false);
         }
 
+        d->connectComboBoxLineEdit(comboBox);
+
         connect(comboBox, &QComboBox::destroyed, this, [d, comboBox]() {
             d->comboBoxDeleted(comboBox);
         });
@@ -615,43 +844,6 @@ bool KSelectAction::event(QEvent *event)
     return QWidgetAction::event(event);
 }
 
-// KSelectAction::eventFilter() is called before action->setChecked()
-// invokes the signal to update QActionGroup so KSelectAction::currentItem()
-// returns an old value.  There are 3 possibilities, where n actions will
-// report QAction::isChecked() where n is:
-//
-// 0: the checked action was unchecked
-// 1: the checked action did not change
-// 2: another action was checked but QActionGroup has not been invoked yet
-//    to uncheck the one that was checked before
-//
-// TODO: we might want to cache this since QEvent::ActionChanged is fired
-//       often.
-static int TrueCurrentItem(KSelectAction *sa)
-{
-    QAction *curAction = sa->currentAction();
-    // qCDebug(KWidgetsAddonsLog) << "\tTrueCurrentItem(" << sa << ") curAction=" << curAction;
-
-    const auto actions = sa->actions();
-    int i = 0;
-    for (QAction *action : actions) {
-        if (action->isChecked()) {
-            // qCDebug(KWidgetsAddonsLog) << "\t\taction " << action << " (text=" << action->text () << ") isChecked";
-
-            // 2 actions checked case?
-            if (action != curAction) {
-                // qCDebug(KWidgetsAddonsLog) << "\t\t\tmust be newly selected one";
-                return i;
-            }
-        }
-        ++i;
-    }
-
-    // qCDebug(KWidgetsAddonsLog) << "\t\tcurrent action still selected? " << (curAction && curAction->isChecked ());
-    // 1 or 0 actions checked case (in that order)?
-    return (curAction && curAction->isChecked()) ? sa->actions().indexOf(curAction) : -1;
-}
-
 bool KSelectAction::eventFilter(QObject *watched, QEvent *event)
 {
     QComboBox *comboBox = qobject_cast<QComboBox *>(watched);
@@ -679,76 +871,6 @@ bool KSelectAction::eventFilter(QObject *watched, QEvent *event)
         return false /*propagate event*/;
     }
 
-    bool blocked = comboBox->blockSignals(true);
-
-    if (event->type() == QEvent::ActionAdded) {
-        QActionEvent *const e = static_cast<QActionEvent *>(event);
-
-        const int index = e->before() ? comboBox->findData(QVariant::fromValue(e->before())) : comboBox->count();
-        const int newItem = ::TrueCurrentItem(this);
-        // qCDebug(KWidgetsAddonsLog) << "KSelectAction::eventFilter(ActionAdded)"
-        //          << "    comboBox: ptr=" << comboBox
-        //          << " currentItem=" << comboBox->currentIndex ()
-        //          << "    add index=" << index
-        //          << "    action new: e->before=" << e->before ()
-        //          << " ptr=" << e->action ()
-        //          << " icon=" << e->action ()->icon ()
-        //          << " text=" << e->action ()->text ()
-        //          << " currentItem=" << newItem
-        //          << endl;
-        comboBox->insertItem(index, e->action()->icon(), ::DropAmpersands(e->action()->text()), QVariant::fromValue(e->action()));
-        if (QStandardItemModel *model = qobject_cast<QStandardItemModel *>(comboBox->model())) {
-            QStandardItem *item = model->item(index);
-            item->setEnabled(e->action()->isEnabled());
-        }
-
-        // Inserting an item into a combobox can change the current item so
-        // make sure the item corresponding to the checked action is selected.
-        comboBox->setCurrentIndex(newItem);
-    } else if (event->type() == QEvent::ActionChanged) {
-        QActionEvent *const e = static_cast<QActionEvent *>(event);
-
-        const int index = comboBox->findData(QVariant::fromValue(e->action()));
-        const int newItem = ::TrueCurrentItem(this);
-        // qCDebug(KWidgetsAddonsLog) << "KSelectAction::eventFilter(ActionChanged)"
-        //          << "    comboBox: ptr=" << comboBox
-        //          << " currentItem=" << comboBox->currentIndex ()
-        //          << "    changed action's index=" << index
-        //          << "    action new: ptr=" << e->action ()
-        //          << " icon=" << e->action ()->icon ()
-        //          << " text=" << e->action ()->text ()
-        //          << " currentItem=" << newItem
-        //          << endl;
-        comboBox->setItemIcon(index, e->action()->icon());
-        comboBox->setItemText(index, ::DropAmpersands(e->action()->text()));
-        if (QStandardItemModel *model = qobject_cast<QStandardItemModel *>(comboBox->model())) {
-            QStandardItem *item = model->item(index);
-            item->setEnabled(e->action()->isEnabled());
-        }
-
-        // The checked action may have become unchecked so
-        // make sure the item corresponding to the checked action is selected.
-        comboBox->setCurrentIndex(newItem);
-    } else if (event->type() == QEvent::ActionRemoved) {
-        QActionEvent *const e = static_cast<QActionEvent *>(event);
-
-        const int index = comboBox->findData(QVariant::fromValue(e->action()));
-        const int newItem = ::TrueCurrentItem(this);
-        // qCDebug(KWidgetsAddonsLog) << "KSelectAction::eventFilter(ActionRemoved)"
-        //          << "    comboBox: ptr=" << comboBox
-        //          << " currentItem=" << comboBox->currentIndex ()
-        //          << "    delete action index=" << index
-        //          << "    new: currentItem=" << newItem
-        //          << endl;
-        comboBox->removeItem(index);
-
-        // Removing an item from a combobox can change the current item so
-        // make sure the item corresponding to the checked action is selected.
-        comboBox->setCurrentIndex(newItem);
-    }
-
-    comboBox->blockSignals(blocked);
-
     return false /*propagate event*/;
 }
 
@@ -23,6 +23,9 @@
 
 #include <QActionGroup>
 #include <QComboBox>
+#include <QHash>
+
+class KSelectActionModel;
 
 class KSelectActionPrivate
 {
@@ -65,6 +68,21 @@ public:
 
     void init();
 
+    void comboBoxReturnPressed(QComboBox *comboBox);
+    void connectComboBoxLineEdit(QComboBox *comboBox);
+
+    void actionInserted(QAction *action, bool appended);
+    void actionRemoved(QAction *action);
+    void actionChanged(QAction *action);
+    void ensureTextIndex() const;
+    void indexActionText(QAction *action) const;
+
+    // Runs a structural change of m_model, keeping the combo boxes from
+    // picking an item of their own meanwhile
+    template<typename Change>
+    void changeModel(Change change);
+    void updateComboBoxesCurrentIndex(int index);
+
     bool m_edit : 1;
     bool m_menuAccelsEnabled : 1;
     int m_comboWidth;
@@ -77,6 +95,18 @@ public:
 
     QList<QToolButton *> m_buttons;
     QList<QComboBox *> m_comboBoxes;
+    // The items of all combo boxes, one row per selectable action
+    KSelectActionModel *m_model = nullptr;
+
+    // Looking up actions by text, see KSelectAction::action(const QString &, Qt::CaseSensitivity).
+    // The first action with a given text wins, as with a linear search.
+    mutable QHash<QString, QAction *> m_actionsByText;
+    mutable QHash<QString, QAction *> m_actionsByFoldedText;
+    mutable QHash<QAction *, QString> m_indexedTexts;
+    mutable bool m_textIndexValid = false;
+
+    // Set while setItems() or clear() repopulate, m_model is reset once instead of per action
+    bool m_bulkUpdate = false;
 
     QString makeMenuText(const QString &_text)
     {
@@ -13,6 +13,8 @@
 #include <QStyle>
 #include <QStyleOption>
 
+#include <optional>
+
 //-----------------------------------------------------------------------------
 /*
  * 1D value selector with contents drawn by derived class.
@@ -24,8 +26,19 @@
 class KSelectorPrivate
 {
 public:
+    static KSelectorPrivate *get(KSelector *q)
+    {
+        return q->d.get();
+    }
+
     bool m_indent = true;
     QStyle::PrimitiveElement arrowPE = QStyle::PE_IndicatorArrowLeft;
+    // Whether value changes repaint only the arrows, and where the arrow was last painted
+    std::optional<bool> arrowOnlyUpdates;
+    QPoint paintedArrowPos;
+    // Unless set explicitly, arrow-only updates are enabled for instances of exactly this
+    // class. The constructors cannot check it, metaObject() is not the final one there.
+    const QMetaObject *arrowOnlyUpdatesClass = nullptr;
 };
 
 class KGradientSelectorPrivate
@@ -36,10 +49,21 @@ public:
     {
     }
 
+    void paintBackground(QPainter *painter);
+    const QPixmap &background();
+
     KGradientSelector *q;
     QLinearGradient gradient;
     QString text1;
     QString text2;
+
+    // The gradient and the texts, as drawn by drawContents(), so the
+    // moving arrow only costs a blit. Dropped when one of them changes, and
+    // rendered again for another geometry, orientation, font or device pixel ratio.
+    QPixmap backgroundCache;
+    QRect backgroundRect;
+    Qt::Orientation backgroundOrientation = Qt::Horizontal;
+    QFont backgroundFont;
 };
 
 KSelector::KSelector(QWidget *parent)
@@ -131,6 +155,7 @@ void KSelector::paintEvent(QPaintEvent *)
 
     QPoint pos = calcArrowPos(value());
     drawArrow(&painter, pos);
+    d->paintedArrowPos = pos;
 
     painter.end();
 }
@@ -172,8 +197,40 @@ void KSelector::moveArrow(const QPoint &pos)
         val = (maximum() - minimum()) * (pos.x() - iw) / (width() - iw * 2) + minimum();
     }
 
+    // The arrows are repainted by sliderChange(), if the value changed
     setValue(val);
-    update();
+}
+
+void KSelector::sliderChange(SliderChange change)
+{
+    if (change != SliderValueChange || !arrowOnlyUpdates()) {
+        QAbstractSlider::sliderChange(change);
+        return;
+    }
+
+    update(arrowRect(d->paintedArrowPos));
+    update(arrowRect(calcArrowPos(value())));
+}
+
+void KSelector::setArrowOnlyUpdates(bool enabled)
+{
+    d->arrowOnlyUpdates = enabled;
+}
+
+bool KSelector::arrowOnlyUpdates() const
+{
+    return d->arrowOnlyUpdates.value_or(metaObject() == d->arrowOnlyUpdatesClass);
+}
+
+QRect KSelector::arrowRect(const QPoint &pos) const
+{
+    // The rect drawArrow() paints into, with some room for styles drawing outside of it
+    const int margin = ARROWSIZE;
+    if (orientation() == Qt::Vertical) {
+        return QRect(pos.x(), pos.y() - ARROWSIZE / 2, ARROWSIZE, ARROWSIZE).adjusted(-margin, -margin, margin, margin);
+    } else {
+        return QRect(pos.x() - ARROWSIZE / 2, pos.y(), ARROWSIZE, ARROWSIZE).adjusted(-margin, -margin, margin, margin);
+    }
 }
 
 QPoint KSelector::calcArrowPos(int val)
@@ -280,25 +337,61 @@ KGradientSelector::KGradientSelector(QWidget *parent)
     : KSelector(parent)
     , d(new KGradientSelectorPrivate(this))
 {
+    // Subclasses may paint the arrows or the contents differently
+    KSelectorPrivate::get(this)->arrowOnlyUpdatesClass = &staticMetaObject;
 }
 
 KGradientSelector::KGradientSelector(Qt::Orientation o, QWidget *parent)
     : KSelector(o, parent)
     , d(new KGradientSelectorPrivate(this))
 {
+    // Subclasses may paint the arrows or the contents differently
+    KSelectorPrivate::get(this)->arrowOnlyUpdatesClass = &staticMetaObject;
 }
 
 KGradientSelector::~KGradientSelector() = default;
 
 void KGradientSelector::drawContents(QPainter *painter)
 {
-    d->gradient.setStart(contentsRect().topLeft());
-    if (orientation() == Qt::Vertical) {
-        d->gradient.setFinalStop(contentsRect().bottomLeft());
+    painter->drawPixmap(contentsRect().topLeft(), d->background());
+}
+
+const QPixmap &KGradientSelectorPrivate::background()
+{
+    const QRect rect = q->contentsRect();
+    const qreal dpr = q->devicePixelRatioF();
+    if (!backgroundCache.isNull() && backgroundRect == rect && backgroundOrientation == q->orientation() && backgroundCache.devicePixelRatio() == dpr
+        && backgroundFont == q->font()) {
+        return backgroundCache;
+    }
+
+    backgroundRect = rect;
+    backgroundOrientation = q->orientation();
+    backgroundFont = q->font();
+    backgroundCache = QPixmap(rect.size() * dpr);
+    backgroundCache.setDevicePixelRatio(dpr);
+    backgroundCache.fill(Qt::transparent);
+
+    QPainter painter(&backgroundCache);
+    painter.setFont(backgroundFont);
+    // Keep the widget coordinates of the painting code, and the alignment of the chessboard
+    painter.translate(-rect.topLeft());
+    paintBackground(&painter);
+    painter.end();
+
+    return backgroundCache;
+}
+
+void KGradientSelectorPrivate::paintBackground(QPainter *painter)
+{
+    const QRect contentsRect = q->contentsRect();
+    gradient.setStart(contentsRect.topLeft());
+    if (q->orientation() == Qt::Vertical) {
+        gradient.setFinalStop(contentsRect.bottomLeft());
     } else {
-        d->gradient.setFinalStop(contentsRect().topRight());
+        gradient.setFinalStop(contentsRect.topRight());
     }
-    QBrush gradientBrush(d->gradient);
+    QBrush gradientBrush(gradient);
 
     if (!gradientBrush.isOpaque()) {
         QPixmap chessboardPattern(16, 16);
@@ -308,32 +401,32 @@ void KGradientSelector::drawContents(QPainter *painter)
         patternPainter.fillRect(0, 8, 8, 8, Qt::white);
         patternPainter.fillRect(8, 0, 8, 8, Qt::white);
         patternPainter.end();
-        painter->fillRect(contentsRect(), QBrush(chessboardPattern));
+        painter->fillRect(contentsRect, QBrush(chessboardPattern));
     }
-    painter->fillRect(contentsRect(), gradientBrush);
+    painter->fillRect(contentsRect, gradientBrush);
 
-    if (orientation() == Qt::Vertical) {
-        int yPos = contentsRect().top() + painter->fontMetrics().ascent() + 2;
-        int xPos = contentsRect().left() + (contentsRect().width() - painter->fontMetrics().horizontalAdvance(d->text2)) / 2;
-        QPen pen(qGray(firstColor().rgb()) > 180 ? Qt::black : Qt::white);
+    if (q->orientation() == Qt::Vertical) {
+        int yPos = contentsRect.top() + painter->fontMetrics().ascent() + 2;
+        int xPos = contentsRect.left() + (contentsRect.width() - painter->fontMetrics().horizontalAdvance(text2)) / 2;
+        QPen pen(qGray(q->firstColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(xPos, yPos, d->text2);
+        painter->drawText(xPos, yPos, text2);
 
-        yPos = contentsRect().bottom() - painter->fontMetrics().descent() - 2;
-        xPos = contentsRect().left() + (contentsRect().width() - painter->fontMetrics().horizontalAdvance(d->text1)) / 2;
-        pen.setColor(qGray(secondColor().rgb()) > 180 ? Qt::black : Qt::white);
+        yPos = contentsRect.bottom() - painter->fontMetrics().descent() - 2;
+        xPos = contentsRect.left() + (contentsRect.width() - painter->fontMetrics().horizontalAdvance(text1)) / 2;
+        pen.setColor(qGray(q->secondColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(xPos, yPos, d->text1);
+        painter->drawText(xPos, yPos, text1);
     } else {
-        int yPos = contentsRect().bottom() - painter->fontMetrics().descent() - 2;
+        int yPos = contentsRect.bottom() - painter->fontMetrics().descent() - 2;
 
-        QPen pen(qGray(firstColor().rgb()) > 180 ? Qt::black : Qt::white);
+        QPen pen(qGray(q->firstColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(contentsRect().left() + 2, yPos, d->text1);
+        painter->drawText(contentsRect.left() + 2, yPos, text1);
 
-        pen.setColor(qGray(secondColor().rgb()) > 180 ? Qt::black : Qt::white);
+        pen.setColor(qGray(q->secondColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(contentsRect().right() - painter->fontMetrics().horizontalAdvance(d->text2) - 2, yPos, d->text2);
+        painter->drawText(contentsRect.right() - painter->fontMetrics().horizontalAdvance(text2) - 2, yPos, text2);
     }
 }
 
@@ -345,6 +438,7 @@ QSize KGradientSelector::minimumSize() const
 void KGradientSelector::setStops(const QGradientStops &stops)
 {
     d->gradient.setStops(stops);
+    d->backgroundCache = QPixmap();
     update();
 }
 
@@ -357,6 +451,7 @@ void KGradientSelector::setColors(const QColor &col1, const QColor &col2)
 {
     d->gradient.setColorAt(0.0, col1);
     d->gradient.setColorAt(1.0, col2);
+    d->backgroundCache = QPixmap();
     update();
 }
 
@@ -364,30 +459,35 @@ void KGradientSelector::setText(const QString &t1, const QString &t2)
 {
     d->text1 = t1;
     d->text2 = t2;
+    d->backgroundCache = QPixmap();
     update();
 }
 
 void KGradientSelector::setFirstColor(const QColor &col)
 {
     d->gradient.setColorAt(0.0, col);
+    d->backgroundCache = QPixmap();
     update();
 }
 
 void KGradientSelector::setSecondColor(const QColor &col)
 {
     d->gradient.setColorAt(1.0, col);
+    d->backgroundCache = QPixmap();
     update();
 }
 
 void KGradientSelector::setFirstText(const QString &t)
 {
     d->text1 = t;
+    d->backgroundCache = QPixmap();
     update();
 }
 
 void KGradientSelector::setSecondText(const QString &t)
 {
     d->text2 = t;
+    d->backgroundCache = QPixmap();
     update();
 }
 
@@ -112,17 +112,42 @@ protected:
     /*!
      * Override this function to draw the cursor which
      * indicates the current value.
+     *
+     * If arrowOnlyUpdates() is enabled, draw within a few pixels of \a pos.
      */
     virtual void drawArrow(QPainter *painter, const QPoint &pos);
 
+    /*!
+     * Sets whether a value change repaints only the area around the old and
+     * the new arrow, instead of the whole selector.
+     *
+     * Enable it if drawArrow() paints within a few pixels of its position and
+     * drawContents() does not depend on the value. Disabled by default,
+     * except for KGradientSelector itself, not for classes derived from it.
+     *
+     * \since 6.30
+     */
+    void setArrowOnlyUpdates(bool enabled);
+
+    /*!
+     * Returns whether a value change repaints only the area around the arrows.
+     *
+     * \sa setArrowOnlyUpdates()
+     *
+     * \since 6.30
+     */
+    bool arrowOnlyUpdates() const;
+
     void paintEvent(QPaintEvent *) override;
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e) override;
     void mouseReleaseEvent(QMouseEvent *e) override;
     void wheelEvent(QWheelEvent *) override;
+    void sliderChange(SliderChange change) override;
 
 private:
     KWIDGETSADDONS_NO_EXPORT QPoint calcArrowPos(int val);
+    KWIDGETSADDONS_NO_EXPORT QRect arrowRect(const QPoint &pos) const;
     KWIDGETSADDONS_NO_EXPORT void moveArrow(const QPoint &pos);
 
 private:
@@ -140,6 +165,9 @@ private:
  * from a one-dimensional range of colors which is given as a
  * gradient between two colors provided by the programmer.
  *
+ * A value change only repaints the arrows, see KSelector::setArrowOnlyUpdates().
+ * Classes derived from it repaint the whole selector unless they enable it.
+ *
  * \image kgradientselector.png "KGradientSelector Widget"
  */
 class KWIDGETSADDONS_EXPORT KGradientSelector : public KSelector
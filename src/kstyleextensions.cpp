@@ -7,6 +7,8 @@
 
 #include "kstyleextensions.h"
 
+#include <QGlobalStatic>
+#include <QHash>
 #include <QWidget>
 
 namespace KStyleExtensions
@@ -38,14 +40,15 @@ namespace KStyleExtensions
     3) If any of the above traps snaps, the returned id is 0 - the QStyle default, indicating
     that this element is not supported by the current style.
 
-    Obviously, this contains the "diminished clean" action to (temporarily) manipulate the
-    objectName() of a const QWidget* - but this happens completely inside KStyle or the widget, if
-    it does not make use of KStyles static convenience functions.
-    My biggest worry here would be, that in a multithreaded environment a thread (usually not being
-    owner of the widget) does something crucially relying on the widgets name property...
-    This however would also have to happen during the widget construction or stylechanges, when
-    the functions in doubt will typically be called.
-    So this is imho unlikely causing any trouble, ever.
+    The answer of the style is cached per style, element and class of the asking widget, so that
+    repeated lookups from paint paths are a hash hit. Only these are distinguished: a style whose
+    answer depends on the parent, palette or other state of the widget gets the answer for the
+    first widget of that class for all later ones. The cache of a style is dropped when the style
+    is destroyed, QApplication::setStyle() deletes the previous style.
+
+    On a cache miss the asking widget itself is passed to the style, with its objectName() set to
+    the element for the duration of the query as described in 1c. A lookup leaving the objectName()
+    alone would need another way to pass the element, which supporting styles do not understand.
 */
 
 /// @private Prevent kapidox's doxygen config to pick up this namespace variable
@@ -58,18 +61,56 @@ static const int X_KdeBase = 0xff000000;
     Collected in a static inline function due to similarity.
 */
 
+/// @private Prevent kapidox's doxygen config to pick up this namespace class
+class CustomElementCache : public QObject
+{
+public:
+    int resolve(QStyle::StyleHint type, const QString &element, QWidget *widget)
+    {
+        QStyle *style = widget->style();
+        auto styleIt = m_elements.find(style);
+        if (styleIt == m_elements.end()) {
+            connect(style, &QObject::destroyed, this, [this, style]() {
+                m_elements.remove(style);
+            });
+            styleIt = m_elements.insert(style, {});
+        }
+
+        const std::pair<const QMetaObject *, QString> key(widget->metaObject(), element);
+        auto it = styleIt->constFind(key);
+        if (it == styleIt->cend()) {
+            it = styleIt->insert(key, query(type, element, widget));
+        }
+        return *it;
+    }
+
+private:
+    static int query(QStyle::StyleHint type, const QString &element, QWidget *widget)
+    {
+        if (widget->style()->metaObject()->indexOfClassInfo("X-KDE-CustomElements") < 0) {
+            return 0;
+        }
+
+        const QString originalName = widget->objectName();
+        widget->setObjectName(element);
+        const int id = widget->style()->styleHint(type, nullptr, widget);
+        widget->setObjectName(originalName);
+        return id;
+    }
+
+    QHash<const QStyle *, QHash<std::pair<const QMetaObject *, QString>, int>> m_elements;
+};
+
+Q_GLOBAL_STATIC(CustomElementCache, s_customElementCache)
+
 /// @private Prevent kapidox's doxygen config to pick up this namespace method
 static inline int customStyleElement(QStyle::StyleHint type, const QString &element, QWidget *widget)
 {
-    if (!widget || widget->style()->metaObject()->indexOfClassInfo("X-KDE-CustomElements") < 0) {
+    if (!widget) {
         return 0;
     }
 
-    const QString originalName = widget->objectName();
-    widget->setObjectName(element);
-    const int id = widget->style()->styleHint(type, nullptr, widget);
-    widget->setObjectName(originalName);
-    return id;
+    return s_customElementCache->resolve(type, element, widget);
 }
 
 QStyle::StyleHint customStyleHint(const QString &element, const QWidget *widget)
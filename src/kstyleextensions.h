@@ -37,6 +37,10 @@
  * 2) Try to avoid custom elements and use default ones (if possible) to get better style support and keep UI coherency
  *
  * 3) If you cache this value (good idea, this requires a map lookup) do not forget to catch style changes in QWidget::changeEvent()!
+ *
+ * 4) The answers are cached per style, element and widget class, a style has to give the same answer
+ * for all widgets of a class. The first lookup for a widget class sets the objectName() of the widget
+ * to the element while the style is asked.
  */
 namespace KStyleExtensions
 {
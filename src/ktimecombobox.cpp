@@ -6,12 +6,182 @@
 
 #include "ktimecombobox.h"
 
+#include <QAbstractListModel>
 #include <QKeyEvent>
 #include <QLineEdit>
 #include <QTime>
 
 #include "kmessagebox.h"
 
+#include <algorithm>
+
+// The times shown in the drop-down list.
+// For an interval based list the times are computed from the row, and all
+// texts are only formatted once the view or the combo box asks for them,
+// so small intervals do not cost thousands of formatted items per widget.
+class KTimeComboBoxModel : public QAbstractListModel
+{
+public:
+    using QAbstractListModel::QAbstractListModel;
+
+    void setInterval(const QTime &minTime, const QTime &maxTime, int minutes);
+    void setTimeList(const QList<QTime> &timeList, const QTime &minTime, const QTime &maxTime);
+    void setFormat(const QLocale &locale, QLocale::FormatType format);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    QTime timeAt(int row) const;
+    // Returns the first row with a time not earlier than time, or the last row
+    int rowForTime(const QTime &time) const;
+
+private:
+    void reset();
+
+    bool m_useTimeList = false;
+    QList<QTime> m_timeList;
+
+    // The interval based list is made of the start time, the interval
+    // times after it and before the end time, and the end time.
+    int m_startMSecs = 0;
+    int m_firstIntervalMSecs = 0;
+    int m_intervalMSecs = 0;
+    int m_intervalCount = 0;
+    int m_endMSecs = 0;
+
+    QLocale m_locale;
+    QLocale::FormatType m_format = QLocale::ShortFormat;
+    mutable QList<QString> m_texts;
+};
+
+void KTimeComboBoxModel::setInterval(const QTime &minTime, const QTime &maxTime, int minutes)
+{
+    static constexpr int msecsPerDay = 24 * 60 * 60 * 1000;
+
+    beginResetModel();
+    m_useTimeList = false;
+    m_timeList.clear();
+    m_startMSecs = minTime.msecsSinceStartOfDay();
+    m_endMSecs = maxTime.msecsSinceStartOfDay();
+    m_intervalMSecs = minutes * 60 * 1000;
+    m_intervalCount = 0;
+    if (m_intervalMSecs > 0) {
+        // The first interval time after the start, counting from the start of its hour
+        const int hourMSecs = minTime.hour() * 60 * 60 * 1000;
+        m_firstIntervalMSecs = hourMSecs + ((m_startMSecs - hourMSecs) / m_intervalMSecs + 1) * m_intervalMSecs;
+        const int limitMSecs = std::min(m_endMSecs, msecsPerDay);
+        if (m_firstIntervalMSecs < limitMSecs) {
+            m_intervalCount = (limitMSecs - m_firstIntervalMSecs - 1) / m_intervalMSecs + 1;
+        }
+    }
+    reset();
+    endResetModel();
+}
+
+void KTimeComboBoxModel::setTimeList(const QList<QTime> &timeList, const QTime &minTime, const QTime &maxTime)
+{
+    beginResetModel();
+    m_useTimeList = true;
+    m_timeList.clear();
+    for (const QTime &thisTime : timeList) {
+        if (thisTime.isValid() && thisTime >= minTime && thisTime <= maxTime) {
+            m_timeList.append(thisTime);
+        }
+    }
+    reset();
+    endResetModel();
+}
+
+void KTimeComboBoxModel::setFormat(const QLocale &locale, QLocale::FormatType format)
+{
+    if (locale == m_locale && format == m_format) {
+        return;
+    }
+    m_locale = locale;
+    m_format = format;
+    m_texts.clear();
+    m_texts.resize(rowCount());
+    if (!m_texts.isEmpty()) {
+        Q_EMIT dataChanged(index(0), index(m_texts.size() - 1), {Qt::DisplayRole, Qt::EditRole});
+    }
+}
+
+void KTimeComboBoxModel::reset()
+{
+    m_texts.clear();
+    m_texts.resize(rowCount());
+}
+
+int KTimeComboBoxModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_useTimeList ? m_timeList.size() : m_intervalCount + 2;
+}
+
+QVariant KTimeComboBoxModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole: {
+        QString &text = m_texts[index.row()];
+        if (text.isNull()) {
+            text = m_locale.toString(timeAt(index.row()), m_format);
+        }
+        return text;
+    }
+    case Qt::UserRole:
+        return timeAt(index.row());
+    default:
+        return QVariant();
+    }
+}
+
+QTime KTimeComboBoxModel::timeAt(int row) const
+{
+    if (row < 0 || row >= rowCount()) {
+        return QTime();
+    }
+    if (m_useTimeList) {
+        return m_timeList.at(row);
+    }
+    if (row == 0) {
+        return QTime::fromMSecsSinceStartOfDay(m_startMSecs);
+    }
+    if (row > m_intervalCount) {
+        return QTime::fromMSecsSinceStartOfDay(m_endMSecs);
+    }
+    return QTime::fromMSecsSinceStartOfDay(m_firstIntervalMSecs + (row - 1) * m_intervalMSecs);
+}
+
+int KTimeComboBoxModel::rowForTime(const QTime &time) const
+{
+    const int count = rowCount();
+    if (count == 0 || !time.isValid()) {
+        return 0;
+    }
+    if (m_useTimeList) {
+        const auto it = std::lower_bound(m_timeList.cbegin(), m_timeList.cend(), time);
+        return std::min<int>(it - m_timeList.cbegin(), count - 1);
+    }
+
+    const int msecs = time.msecsSinceStartOfDay();
+    if (msecs <= m_startMSecs) {
+        return 0;
+    }
+    if (m_intervalCount == 0 || msecs > m_firstIntervalMSecs + (m_intervalCount - 1) * m_intervalMSecs) {
+        return count - 1;
+    }
+    // Round up to the next interval time
+    const int intervals = std::max(0, (msecs - m_firstIntervalMSecs + m_intervalMSecs - 1) / m_intervalMSecs);
+    return 1 + intervals;
+}
+
 class KTimeComboBoxPrivate
 {
 public:
@@ -48,6 +218,7 @@ public:
     QLocale::FormatType m_displayFormat;
     int m_timeListInterval;
     QList<QTime> m_timeList;
+    KTimeComboBoxModel *m_model = nullptr;
 };
 
 KTimeComboBoxPrivate::KTimeComboBoxPrivate(KTimeComboBox *qq)
@@ -117,19 +288,10 @@ std::pair<QString, QString> KTimeComboBoxPrivate::timeFormatToInputMask(const QS
     return std::make_pair(mask, null);
 }
 
+// Rounds up to the first time of the list not earlier than time, or to the last one
 QTime KTimeComboBoxPrivate::nearestIntervalTime(const QTime &time)
 {
-    int i = 0;
-    while (q->itemData(i).toTime() < time) {
-        ++i;
-    }
-    QTime before = q->itemData(i).toTime();
-    QTime after = q->itemData(i + 1).toTime();
-    if (before.secsTo(time) <= time.secsTo(after)) {
-        return before;
-    } else {
-        return after;
-    }
+    return m_model->timeAt(m_model->rowForTime(time));
 }
 
 QString KTimeComboBoxPrivate::formatTime(const QTime &time)
@@ -140,7 +302,6 @@ QString KTimeComboBoxPrivate::formatTime(const QTime &time)
 void KTimeComboBoxPrivate::initTimeWidget()
 {
     q->blockSignals(true);
-    q->clear();
 
     // Set the input mask from the current format
     QString mask;
@@ -160,30 +321,18 @@ void KTimeComboBoxPrivate::initTimeWidget()
     // Populate the drop-down time list
     // If no time list set the use the time interval
     if (m_timeList.isEmpty()) {
-        QTime startTime = m_minTime;
-        QTime thisTime(startTime.hour(), 0, 0, 0);
-        while (thisTime.isValid() && thisTime <= startTime) {
-            thisTime = thisTime.addSecs(m_timeListInterval * 60);
-        }
-        QTime endTime = m_maxTime;
-        q->addItem(formatTime(startTime), startTime);
-        while (thisTime.isValid() && thisTime < endTime) {
-            q->addItem(formatTime(thisTime), thisTime);
-            QTime newTime = thisTime.addSecs(m_timeListInterval * 60);
-            if (newTime.isValid() && newTime > thisTime) {
-                thisTime = newTime;
-            } else {
-                thisTime = QTime();
-            }
-        }
-        q->addItem(formatTime(endTime), endTime);
+        m_model->setInterval(m_minTime, m_maxTime, m_timeListInterval);
     } else {
-        for (const QTime &thisTime : std::as_const(m_timeList)) {
-            if (thisTime.isValid() && thisTime >= m_minTime && thisTime <= m_maxTime) {
-                q->addItem(formatTime(thisTime), thisTime);
-            }
-        }
+        m_model->setTimeList(m_timeList, m_minTime, m_maxTime);
+    }
+    m_model->setFormat(q->locale(), m_displayFormat);
+
+    // Size for the widest time instead of formatting every entry
+    int contentsLength = 0;
+    for (const QTime &sample : {m_minTime, m_maxTime, QTime(11, 59, 59, 999), QTime(23, 59, 59, 999)}) {
+        contentsLength = std::max<int>(contentsLength, formatTime(sample).length());
     }
+    q->setMinimumContentsLength(contentsLength);
     q->blockSignals(false);
 }
 
@@ -198,9 +347,7 @@ void KTimeComboBoxPrivate::updateTimeWidget()
     } else if (m_time > m_maxTime) {
         i = q->count() - 1;
     } else {
-        while (q->itemData(i).toTime() < m_time && i < q->count() - 1) {
-            ++i;
-        }
+        i = m_model->rowForTime(m_time);
     }
     q->setCurrentIndex(i);
     if (m_time.isValid()) {
@@ -265,9 +412,11 @@ KTimeComboBox::KTimeComboBox(QWidget *parent)
     : QComboBox(parent)
     , d(new KTimeComboBoxPrivate(this))
 {
+    d->m_model = new KTimeComboBoxModel(this);
+    setModel(d->m_model);
     setEditable(true);
     setInsertPolicy(QComboBox::NoInsert);
-    setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
     d->initTimeWidget();
     d->updateTimeWidget();
 
@@ -0,0 +1,237 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kwidgetsaddonstiming_p.h"
+
+#include "loggingcategory.h"
+
+#include <QCoreApplication>
+#include <QGlobalStatic>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace KWidgetsAddonsTiming
+{
+static std::atomic<bool> s_enabled = false;
+
+// Seconds between two dumps to the log, 0 for none. Read on first use rather
+// than when the library is loaded, which applications not timing anything pay for
+static int dumpInterval()
+{
+    static const int interval = [] {
+        const int seconds = std::max(qEnvironmentVariableIntValue("KWIDGETSADDONS_TIMING"), 0);
+        if (seconds > 0) {
+            s_enabled.store(true, std::memory_order_relaxed);
+        }
+        return seconds;
+    }();
+    return interval;
+}
+
+// The upper limit of the first histogram bucket, each next one doubles it
+static constexpr qint64 FIRST_BUCKET_NSECS = 250000;
+
+class StatisticsPrivate : public QSharedData
+{
+public:
+    QByteArray className;
+    Operation operation = Paint;
+    qint64 count = 0;
+    qint64 totalNsecs = 0;
+    qint64 maximumNsecs = 0;
+    QList<qint64> histogram = QList<qint64>(HistogramSize, 0);
+};
+
+Statistics::Statistics()
+    : d(new StatisticsPrivate)
+{
+}
+
+Statistics::Statistics(const QSharedDataPointer<StatisticsPrivate> &d)
+    : d(d)
+{
+}
+
+Statistics::Statistics(const Statistics &other) = default;
+
+Statistics &Statistics::operator=(const Statistics &other) = default;
+
+Statistics::~Statistics() = default;
+
+QByteArray Statistics::className() const
+{
+    return d->className;
+}
+
+Operation Statistics::operation() const
+{
+    return d->operation;
+}
+
+qint64 Statistics::count() const
+{
+    return d->count;
+}
+
+qint64 Statistics::totalNsecs() const
+{
+    return d->totalNsecs;
+}
+
+qint64 Statistics::maximumNsecs() const
+{
+    return d->maximumNsecs;
+}
+
+QList<qint64> Statistics::histogram() const
+{
+    return d->histogram;
+}
+
+struct TimingData {
+    QMutex mutex;
+    // Shared with the Statistics returned by statistics(), detached when recording again
+    QHash<std::pair<QByteArray, int>, QSharedDataPointer<StatisticsPrivate>> statistics;
+    bool dumpTimerStarted = false;
+};
+
+Q_GLOBAL_STATIC(TimingData, s_timingData)
+
+static int histogramBucket(qint64 nsecs)
+{
+    qint64 limit = FIRST_BUCKET_NSECS;
+    for (int bucket = 0; bucket < HistogramSize - 1; ++bucket) {
+        if (nsecs < limit) {
+            return bucket;
+        }
+        limit *= 2;
+    }
+    return HistogramSize - 1;
+}
+
+static const char *operationName(Operation operation)
+{
+    switch (operation) {
+    case Paint:
+        return "paint";
+    case Layout:
+        return "layout";
+    case ModelQuery:
+        return "model query";
+    }
+    return "";
+}
+
+static void startDumpTimer()
+{
+    // The timer lives in the main thread, with the widgets it reports on
+    if (dumpInterval() <= 0 || !QCoreApplication::instance() || !QThread::isMainThread()) {
+        return;
+    }
+
+    auto timer = new QTimer(QCoreApplication::instance());
+    QObject::connect(timer, &QTimer::timeout, timer, []() {
+        if (isEnabled()) {
+            qCInfo(KWidgetsAddonsLog).noquote() << "Timing statistics:\n" << report();
+        }
+    });
+    timer->start(dumpInterval() * 1000);
+    s_timingData->dumpTimerStarted = true;
+}
+
+bool isEnabled()
+{
+    dumpInterval();
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool enabled)
+{
+    // Let the environment be read first, not to override this later
+    dumpInterval();
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void record(const char *className, Operation operation, qint64 nsecs)
+{
+    TimingData *data = s_timingData();
+    QMutexLocker locker(&data->mutex);
+
+    // className is a literal, no need to copy it for the lookup
+    const std::pair<QByteArray, int> key(QByteArray::fromRawData(className, qstrlen(className)), operation);
+    QSharedDataPointer<StatisticsPrivate> &statistics = data->statistics[key];
+    if (!statistics) {
+        statistics.reset(new StatisticsPrivate);
+        statistics->className = key.first;
+        statistics->operation = operation;
+    }
+
+    ++statistics->count;
+    statistics->totalNsecs += nsecs;
+    statistics->maximumNsecs = std::max(statistics->maximumNsecs, nsecs);
+    ++statistics->histogram[histogramBucket(nsecs)];
+
+    if (!data->dumpTimerStarted) {
+        startDumpTimer();
+    }
+}
+
+QList<Statistics> statistics()
+{
+    TimingData *data = s_timingData();
+    QList<Statistics> result;
+    {
+        QMutexLocker locker(&data->mutex);
+        result.reserve(data->statistics.size());
+        for (const QSharedDataPointer<StatisticsPrivate> &statistics : std::as_const(data->statistics)) {
+            result.append(Statistics(statistics));
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Statistics &a, const Statistics &b) {
+        return std::pair(a.className(), a.operation()) < std::pair(b.className(), b.operation());
+    });
+    return result;
+}
+
+void reset()
+{
+    TimingData *data = s_timingData();
+    QMutexLocker locker(&data->mutex);
+    data->statistics.clear();
+}
+
+QString report()
+{
+    QString result;
+    const QList<Statistics> allStatistics = statistics();
+    for (const Statistics &statistics : allStatistics) {
+        QString histogram;
+        const QList<qint64> counts = statistics.histogram();
+        for (qint64 count : counts) {
+            if (!histogram.isEmpty()) {
+                histogram += QLatin1Char(' ');
+            }
+            histogram += QString::number(count);
+        }
+
+        result += QStringLiteral("%1 %2: %3 calls, %4 ms average, %5 ms maximum, histogram [%6]\n")
+                      .arg(QLatin1String(statistics.className()), QLatin1String(operationName(statistics.operation())))
+                      .arg(statistics.count())
+                      .arg(statistics.totalNsecs() / 1e6 / statistics.count(), 0, 'f', 3)
+                      .arg(statistics.maximumNsecs() / 1e6, 0, 'f', 3)
+                      .arg(histogram);
+    }
+    return result;
+}
+}
@@ -0,0 +1,166 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KWIDGETSADDONSTIMING_H
+#define KWIDGETSADDONSTIMING_H
+
+#include <kwidgetsaddons_export.h>
+
+#include <QByteArray>
+#include <QList>
+#include <QSharedDataPointer>
+#include <QString>
+
+/*!
+ * \namespace KWidgetsAddonsTiming
+ * \inmodule KWidgetsAddons
+ *
+ * \brief Records where KWidgetsAddons widgets spend their time.
+ *
+ * When enabled, the painting, layout and model queries of the more expensive
+ * widgets of the library, like KCharSelect, KDateTable, KMultiTabBar,
+ * KRatingPainter or the search of KPageView, are timed, and the durations are
+ * aggregated per class and operation. When disabled, which is the default,
+ * the cost of the instrumentation is the check whether it is enabled.
+ *
+ * Recording is enabled with setEnabled(), or by setting the environment
+ * variable \c KWIDGETSADDONS_TIMING to a number of seconds: the statistics
+ * are then also written to the \c kf.kwidgetsaddons logging category at that
+ * interval, so that jank in production builds can be attributed without
+ * rebuilding anything.
+ *
+ * \code
+ * KWIDGETSADDONS_TIMING=10 kate
+ * \endcode
+ *
+ * \since 6.30
+ */
+namespace KWidgetsAddonsTiming
+{
+/*!
+ * The operations which are timed.
+ *
+ * \value Paint Painting a widget, or an item of it
+ * \value Layout Computing the geometry of a widget or of its contents
+ * \value ModelQuery Querying or filtering a model
+ */
+enum Operation {
+    Paint,
+    Layout,
+    ModelQuery,
+};
+
+/*!
+ * The number of buckets of Statistics::histogram().
+ */
+constexpr int HistogramSize = 8;
+
+class Statistics;
+class StatisticsPrivate;
+
+KWIDGETSADDONS_EXPORT QList<Statistics> statistics();
+
+/*!
+ * \class KWidgetsAddonsTiming::Statistics
+ * \inmodule KWidgetsAddons
+ *
+ * \brief The durations recorded for an operation of a class.
+ *
+ * \since 6.30
+ */
+class KWIDGETSADDONS_EXPORT Statistics
+{
+public:
+    /*!
+     * Constructs empty statistics, of no class.
+     */
+    Statistics();
+    Statistics(const Statistics &other);
+    Statistics &operator=(const Statistics &other);
+    ~Statistics();
+
+    /*!
+     * Returns the name of the class the durations were recorded for.
+     */
+    QByteArray className() const;
+
+    /*!
+     * Returns the operation the durations were recorded for.
+     */
+    Operation operation() const;
+
+    /*!
+     * Returns the number of durations recorded.
+     */
+    qint64 count() const;
+
+    /*!
+     * Returns the sum of the durations, in nanoseconds.
+     */
+    qint64 totalNsecs() const;
+
+    /*!
+     * Returns the longest duration, in nanoseconds.
+     */
+    qint64 maximumNsecs() const;
+
+    /*!
+     * Returns the number of durations in each of the HistogramSize buckets.
+     *
+     * Bucket \c i counts the durations shorter than 2^i / 4 milliseconds, and
+     * not counted by the previous buckets. The last bucket counts the durations
+     * of 16 milliseconds and more, which are a dropped frame at 60 Hz.
+     */
+    QList<qint64> histogram() const;
+
+private:
+    friend QList<Statistics> statistics();
+    explicit Statistics(const QSharedDataPointer<StatisticsPrivate> &d);
+
+    QSharedDataPointer<StatisticsPrivate> d;
+};
+
+/*!
+ * Returns whether durations are recorded.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT bool isEnabled();
+
+/*!
+ * Enables or disables recording durations. Statistics recorded so far are
+ * kept.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT void setEnabled(bool enabled);
+
+/*!
+ * Returns the statistics recorded since the start, or since the last reset(),
+ * sorted by class name and operation.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT QList<Statistics> statistics();
+
+/*!
+ * Discards the statistics recorded so far.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT void reset();
+
+/*!
+ * Returns the statistics as a human-readable table, one line per class and
+ * operation, as written to the log when dumped periodically.
+ *
+ * \since 6.30
+ */
+KWIDGETSADDONS_EXPORT QString report();
+}
+
+#endif // KWIDGETSADDONSTIMING_H
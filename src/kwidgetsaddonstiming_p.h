@@ -0,0 +1,53 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KWIDGETSADDONSTIMING_P_H
+#define KWIDGETSADDONSTIMING_P_H
+
+#include "kwidgetsaddonstiming.h"
+
+#include <QElapsedTimer>
+
+namespace KWidgetsAddonsTiming
+{
+void record(const char *className, Operation operation, qint64 nsecs);
+
+/*!
+ * \internal
+ *
+ * Times its scope and records the duration for \a className, if recording
+ * is enabled when it is created. \a className must be a string literal.
+ */
+class ScopedTimer
+{
+public:
+    ScopedTimer(const char *className, Operation operation)
+        : m_className(className)
+        , m_operation(operation)
+    {
+        if (isEnabled()) {
+            m_timer.start();
+        }
+    }
+
+    ~ScopedTimer()
+    {
+        if (m_timer.isValid()) {
+            record(m_className, m_operation, m_timer.nsecsElapsed());
+        }
+    }
+
+    Q_DISABLE_COPY_MOVE(ScopedTimer)
+
+private:
+    const char *const m_className;
+    const Operation m_operation;
+    QElapsedTimer m_timer;
+};
+}
+
+#endif
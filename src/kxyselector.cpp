@@ -20,11 +20,21 @@
  * The contents of the selector are drawn by derived class.
  */
 
+// How far the marker may extend from its position, see drawMarker()
+static constexpr int MARKER_EXTENT = 10;
+
+static QRect markerRect(int xp, int yp)
+{
+    return QRect(xp - MARKER_EXTENT, yp - MARKER_EXTENT, 2 * MARKER_EXTENT + 1, 2 * MARKER_EXTENT + 1);
+}
+
 class KXYSelectorPrivate
 {
 public:
     KXYSelectorPrivate(KXYSelector *qq)
         : q(qq)
+        , px(0)
+        , py(0)
         , xPos(0)
         , yPos(0)
         , minX(0)
@@ -47,6 +57,7 @@ public:
     int minY;
     int maxY;
     QColor m_markerColor;
+    bool markerOnlyUpdates = false;
 };
 
 KXYSelector::KXYSelector(QWidget *parent)
@@ -221,10 +232,32 @@ void KXYSelector::setPosition(int xp, int yp)
         yp = height() - w;
     }
 
+    if (!d->markerOnlyUpdates) {
+        d->px = xp;
+        d->py = yp;
+        update();
+        return;
+    }
+
+    if (xp == d->px && yp == d->py) {
+        return;
+    }
+
+    // Only the marker moves, the contents stay the same
+    update(markerRect(d->px, d->py));
     d->px = xp;
     d->py = yp;
+    update(markerRect(d->px, d->py));
+}
 
-    update();
+void KXYSelector::setMarkerOnlyUpdates(bool enabled)
+{
+    d->markerOnlyUpdates = enabled;
+}
+
+bool KXYSelector::markerOnlyUpdates() const
+{
+    return d->markerOnlyUpdates;
 }
 
 void KXYSelector::drawContents(QPainter *)
@@ -123,9 +123,33 @@ protected:
     /*!
      * Override this function to draw the marker which
      * indicates the currently selected value pair.
+     *
+     * If markerOnlyUpdates() is enabled, draw within 10 pixels of
+     * (\a xp, \a yp).
      */
     virtual void drawMarker(QPainter *p, int xp, int yp);
 
+    /*!
+     * Sets whether a change of the values repaints only the area around the
+     * old and the new marker, instead of the whole selector.
+     *
+     * Enable it if drawMarker() paints within 10 pixels of its position and
+     * drawContents() does not depend on the values. Disabled by default.
+     *
+     * \since 6.30
+     */
+    void setMarkerOnlyUpdates(bool enabled);
+
+    /*!
+     * Returns whether a change of the values repaints only the area around
+     * the markers.
+     *
+     * \sa setMarkerOnlyUpdates()
+     *
+     * \since 6.30
+     */
+    bool markerOnlyUpdates() const;
+
     void paintEvent(QPaintEvent *e) override;
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e) override;
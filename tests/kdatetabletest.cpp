@@ -9,7 +9,11 @@ int main(int argc, char **argv)
     QApplication app(argc, argv);
 
     KDateTable widget;
+    widget.beginCustomDatePaintingUpdate();
+    widget.setCustomWeekdayPainting(Qt::Wednesday, QColor("blue"));
+    widget.setCustomDatePainting(QDate::currentDate().addDays(2), QDate::currentDate().addDays(5), QColor("white"), KDateTable::RectangleMode, QColor("red"));
     widget.setCustomDatePainting(QDate::currentDate().addDays(-3), QColor("green"), KDateTable::CircleMode, QColor("yellow"));
+    widget.endCustomDatePaintingUpdate();
     widget.show();
 
     return app.exec();